@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Description: Cortex-M3 CMSDK subsystem of the Arm MPS2 AN385 FPGA image,
+ *              also emulated by QEMU (-M mps2-an385).
+ */
+
+#ifndef CMSDK_CM3_H_
+#define CMSDK_CM3_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*******************************************************************************
+ *  Interrupt Number Definition
+ ******************************************************************************/
+
+typedef enum IRQn {
+/* Cortex-M3 Processor Exceptions Numbers */
+  NonMaskableInt_IRQn     = -14,    /*!<  2 Non Maskable Interrupt           */
+  HardFault_IRQn          = -13,    /*!<  3 HardFault Interrupt              */
+  MemoryManagement_IRQn   = -12,    /*!<  4 Memory Management Interrupt      */
+  BusFault_IRQn           = -11,    /*!<  5 Bus Fault Interrupt              */
+  UsageFault_IRQn         = -10,    /*!<  6 Usage Fault Interrupt            */
+  SVCall_IRQn             =  -5,    /*!< 11 SV Call Interrupt                */
+  DebugMonitor_IRQn       =  -4,    /*!< 12 Debug Monitor Interrupt          */
+  PendSV_IRQn             =  -2,    /*!< 14 Pend SV Interrupt                */
+  SysTick_IRQn            =  -1,    /*!< 15 System Tick Interrupt            */
+
+/* CMSDK Specific Interrupt Numbers */
+  UART0RX_IRQn            =   0,    /*!< UART 0 RX Interrupt                 */
+  UART0TX_IRQn            =   1,    /*!< UART 0 TX Interrupt                 */
+  UART1RX_IRQn            =   2,    /*!< UART 1 RX Interrupt                 */
+  UART1TX_IRQn            =   3,    /*!< UART 1 TX Interrupt                 */
+  UART2RX_IRQn            =   4,    /*!< UART 2 RX Interrupt                 */
+  UART2TX_IRQn            =   5,    /*!< UART 2 TX Interrupt                 */
+  PORT0_ALL_IRQn          =   6,    /*!< GPIO Port 0 combined Interrupt      */
+  PORT1_ALL_IRQn          =   7,    /*!< GPIO Port 1 combined Interrupt      */
+  TIMER0_IRQn             =   8,    /*!< TIMER 0 Interrupt                   */
+  TIMER1_IRQn             =   9,    /*!< TIMER 1 Interrupt                   */
+  DUALTIMER_IRQn          =  10,    /*!< Dual Timer Interrupt                */
+  SPI_IRQn                =  11,    /*!< SPI Interrupt                       */
+  UARTOVF_IRQn            =  12,    /*!< UART 0,1,2 Overflow Interrupt       */
+  ETHERNET_IRQn           =  13,    /*!< Ethernet Interrupt                  */
+  I2S_IRQn                =  14,    /*!< I2S Interrupt                       */
+  TSC_IRQn                =  15,    /*!< Touch Screen Interrupt              */
+  IRQ16_IRQn    =  16,    /*!< Interrupt 16 (not connected)                  */
+  IRQ17_IRQn    =  17,    /*!< Interrupt 17 (not connected)                  */
+  IRQ18_IRQn    =  18,    /*!< Interrupt 18 (not connected)                  */
+  IRQ19_IRQn    =  19,    /*!< Interrupt 19 (not connected)                  */
+  IRQ20_IRQn    =  20,    /*!< Interrupt 20 (not connected)                  */
+  IRQ21_IRQn    =  21,    /*!< Interrupt 21 (not connected)                  */
+  IRQ22_IRQn    =  22,    /*!< Interrupt 22 (not connected)                  */
+  IRQ23_IRQn    =  23,    /*!< Interrupt 23 (not connected)                  */
+  IRQ24_IRQn    =  24,    /*!< Interrupt 24 (not connected)                  */
+  IRQ25_IRQn    =  25,    /*!< Interrupt 25 (not connected)                  */
+  IRQ26_IRQn    =  26,    /*!< Interrupt 26 (not connected)                  */
+  IRQ27_IRQn    =  27,    /*!< Interrupt 27 (not connected)                  */
+  IRQ28_IRQn    =  28,    /*!< Interrupt 28 (not connected)                  */
+  IRQ29_IRQn    =  29,    /*!< Interrupt 29 (not connected)                  */
+  IRQ30_IRQn    =  30,    /*!< Interrupt 30 (not connected)                  */
+  IRQ31_IRQn    =  31,    /*!< Interrupt 31 (not connected)                  */
+} IRQn_Type;
+
+/*******************************************************************************
+ *  Processor and Core Peripheral Section
+ ******************************************************************************/
+
+#define __CM3_REV                 0x0201U   /*!< Core Revision r2p1                  */
+#define __MPU_PRESENT             1U        /*!< MPU present                         */
+#define __VTOR_PRESENT            1U        /*!< VTOR present                        */
+#define __NVIC_PRIO_BITS          3U        /*!< Number of Bits used for Priority Levels */
+#define __Vendor_SysTickConfig    0U        /*!< Set to 1 if different SysTick Config is used */
+
+#include "CMSIS/Core/Cortex/core_cm3.h"
+#include "asm/system_CMSDK_CM3.h"
+
+/*******************************************************************************
+ *  Device Specific Peripheral Section
+ ******************************************************************************/
+
+/* UART */
+typedef struct {
+  __IOM uint32_t DATA;                /*!< Offset: 0x000 Data Register                 */
+  __IOM uint32_t STATE;               /*!< Offset: 0x004 Status Register               */
+  __IOM uint32_t CTRL;                /*!< Offset: 0x008 Control Register              */
+  __IOM uint32_t INTSTATUS;           /*!< Offset: 0x00C Interrupt Status/Clear Register */
+  __IOM uint32_t BAUDDIV;             /*!< Offset: 0x010 Baudrate Divider Register     */
+} CMSDK_UART_TypeDef;
+
+#define CMSDK_UART_STATE_TXBF_Msk     (1UL << 0)    /*!< TX buffer full                  */
+#define CMSDK_UART_STATE_RXBF_Msk     (1UL << 1)    /*!< RX buffer full                  */
+#define CMSDK_UART_CTRL_TXEN_Msk      (1UL << 0)    /*!< TX enable                       */
+#define CMSDK_UART_CTRL_RXEN_Msk      (1UL << 1)    /*!< RX enable                       */
+
+#define CMSDK_UART0_BASE              (0x40004000UL)
+#define CMSDK_UART1_BASE              (0x40005000UL)
+#define CMSDK_UART2_BASE              (0x40006000UL)
+
+#define CMSDK_UART0                   ((CMSDK_UART_TypeDef *)CMSDK_UART0_BASE)
+#define CMSDK_UART1                   ((CMSDK_UART_TypeDef *)CMSDK_UART1_BASE)
+#define CMSDK_UART2                   ((CMSDK_UART_TypeDef *)CMSDK_UART2_BASE)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* CMSDK_CM3_H_ */
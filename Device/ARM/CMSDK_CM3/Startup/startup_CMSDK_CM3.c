@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "asm/CMSDK_CM3.h"
+
+/*----------------------------------------------------------------------------
+  Exception / Interrupt Handler Function Prototype
+ *----------------------------------------------------------------------------*/
+typedef void( *pFunc )( void );
+
+/*----------------------------------------------------------------------------
+  External References
+ *----------------------------------------------------------------------------*/
+extern uint32_t __INITIAL_SP;
+
+extern __NO_RETURN void __PROGRAM_START(void);
+
+/*----------------------------------------------------------------------------
+  Internal References
+ *----------------------------------------------------------------------------*/
+void __NO_RETURN Default_Handler(void);
+void __NO_RETURN Reset_Handler  (void);
+
+/*----------------------------------------------------------------------------
+  Exception / Interrupt Handler
+ *----------------------------------------------------------------------------*/
+/* Exceptions */
+void NMI_Handler                   (void) __attribute__ ((weak, alias("Default_Handler")));
+void HardFault_Handler             (void) __attribute__ ((weak, alias("Default_Handler")));
+void MemManage_Handler             (void) __attribute__ ((weak, alias("Default_Handler")));
+void BusFault_Handler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void UsageFault_Handler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void SVC_Handler                   (void) __attribute__ ((weak, alias("Default_Handler")));
+void DebugMon_Handler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void PendSV_Handler                (void) __attribute__ ((weak, alias("Default_Handler")));
+void SysTick_Handler               (void) __attribute__ ((weak, alias("Default_Handler")));
+
+void UART0RX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void UART0TX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void UART1RX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void UART1TX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void UART2RX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void UART2TX_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void PORT0_ALL_IRQHandler          (void) __attribute__ ((weak, alias("Default_Handler")));
+void PORT1_ALL_IRQHandler          (void) __attribute__ ((weak, alias("Default_Handler")));
+void TIMER0_IRQHandler             (void) __attribute__ ((weak, alias("Default_Handler")));
+void TIMER1_IRQHandler             (void) __attribute__ ((weak, alias("Default_Handler")));
+void DUALTIMER_IRQHandler          (void) __attribute__ ((weak, alias("Default_Handler")));
+void SPI_IRQHandler                (void) __attribute__ ((weak, alias("Default_Handler")));
+void UARTOVF_IRQHandler            (void) __attribute__ ((weak, alias("Default_Handler")));
+void ETHERNET_IRQHandler           (void) __attribute__ ((weak, alias("Default_Handler")));
+void I2S_IRQHandler                (void) __attribute__ ((weak, alias("Default_Handler")));
+void TSC_IRQHandler                (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ16_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ17_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ18_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ19_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ20_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ21_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ22_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ23_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ24_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ25_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ26_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ27_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ28_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ29_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ30_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+void IRQ31_IRQHandler              (void) __attribute__ ((weak, alias("Default_Handler")));
+
+/*----------------------------------------------------------------------------
+  Exception / Interrupt Vector table
+ *----------------------------------------------------------------------------*/
+
+#if defined ( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+extern const pFunc __VECTOR_TABLE[];
+       const pFunc __VECTOR_TABLE[] __VECTOR_TABLE_ATTRIBUTE = {
+  (pFunc)(&__INITIAL_SP),           /*     Initial Stack Pointer              */
+  Reset_Handler,                    /*     Reset Handler                      */
+  NMI_Handler,                      /* -14 NMI Handler                        */
+  HardFault_Handler,                /* -13 Hard Fault Handler                 */
+  MemManage_Handler,                /* -12 MPU Fault Handler                  */
+  BusFault_Handler,                 /* -11 Bus Fault Handler                  */
+  UsageFault_Handler,               /* -10 Usage Fault Handler                */
+  0,                                /*     Reserved                           */
+  0,                                /*     Reserved                           */
+  0,                                /*     Reserved                           */
+  0,                                /*     Reserved                           */
+  SVC_Handler,                      /*  -5 SVCall Handler                     */
+  DebugMon_Handler,                 /*  -4 Debug Monitor Handler              */
+  0,                                /*     Reserved                           */
+  PendSV_Handler,                   /*  -2 PendSV Handler                     */
+  SysTick_Handler,                  /*  -1 SysTick Handler                    */
+
+  /* Interrupts */
+  UART0RX_IRQHandler,              /* UART 0 RX                              */
+  UART0TX_IRQHandler,              /* UART 0 TX                              */
+  UART1RX_IRQHandler,              /* UART 1 RX                              */
+  UART1TX_IRQHandler,              /* UART 1 TX                              */
+  UART2RX_IRQHandler,              /* UART 2 RX                              */
+  UART2TX_IRQHandler,              /* UART 2 TX                              */
+  PORT0_ALL_IRQHandler,            /* GPIO Port 0 combined                   */
+  PORT1_ALL_IRQHandler,            /* GPIO Port 1 combined                   */
+  TIMER0_IRQHandler,               /* TIMER 0                                */
+  TIMER1_IRQHandler,               /* TIMER 1                                */
+  DUALTIMER_IRQHandler,            /* Dual Timer                             */
+  SPI_IRQHandler,                  /* SPI                                    */
+  UARTOVF_IRQHandler,              /* UART 0,1,2 Overflow                    */
+  ETHERNET_IRQHandler,             /* Ethernet                               */
+  I2S_IRQHandler,                  /* I2S                                    */
+  TSC_IRQHandler,                  /* Touch Screen                           */
+  IRQ16_IRQHandler,                /* Interrupt 16                           */
+  IRQ17_IRQHandler,                /* Interrupt 17                           */
+  IRQ18_IRQHandler,                /* Interrupt 18                           */
+  IRQ19_IRQHandler,                /* Interrupt 19                           */
+  IRQ20_IRQHandler,                /* Interrupt 20                           */
+  IRQ21_IRQHandler,                /* Interrupt 21                           */
+  IRQ22_IRQHandler,                /* Interrupt 22                           */
+  IRQ23_IRQHandler,                /* Interrupt 23                           */
+  IRQ24_IRQHandler,                /* Interrupt 24                           */
+  IRQ25_IRQHandler,                /* Interrupt 25                           */
+  IRQ26_IRQHandler,                /* Interrupt 26                           */
+  IRQ27_IRQHandler,                /* Interrupt 27                           */
+  IRQ28_IRQHandler,                /* Interrupt 28                           */
+  IRQ29_IRQHandler,                /* Interrupt 29                           */
+  IRQ30_IRQHandler,                /* Interrupt 30                           */
+  IRQ31_IRQHandler,                /* Interrupt 31                           */
+};
+
+#if defined ( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
+
+/*----------------------------------------------------------------------------
+  Reset Handler called on controller reset
+ *----------------------------------------------------------------------------*/
+void Reset_Handler(void)
+{
+  SystemInit();                      /* CMSIS System Initialization           */
+  __PROGRAM_START();                 /* Enter PreMain (C library entry point) */
+}
+
+/*----------------------------------------------------------------------------
+  Default Handler for Exceptions / Interrupts
+ *----------------------------------------------------------------------------*/
+void Default_Handler(void)
+{
+  while(1);
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2019-2021 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ * Title:   Kernel Configuration definitions
+ */
+
+#ifndef _KERNEL_CONFIG_H_
+#define _KERNEL_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h>System Configuration
+// =======================
+
+//   <o>Kernel Tick Frequency [Hz] <1-1000000>
+//   <i> Defines base time unit for delays and timeouts.
+//   <i> Default: 1000 (1ms tick)
+#ifndef OS_TICK_FREQ
+#define OS_TICK_FREQ                1000
+#endif
+
+//   <e>Round-Robin Thread switching
+//   <i> Enables Round-Robin Thread switching.
+#ifndef OS_ROBIN_ENABLE
+#define OS_ROBIN_ENABLE             0
+#endif
+
+//     <o>Round-Robin Timeout <1-1000>
+//     <i> Defines how many ticks a thread will execute before a thread switch.
+//     <i> Default: 5
+#ifndef OS_ROBIN_TIMEOUT
+#define OS_ROBIN_TIMEOUT            5
+#endif
+
+//   </e>
+
+//   <q>Tickless Idle
+//   <i> Stops the Kernel Tick in the Idle Thread until the next timeout.
+#ifndef OS_TICKLESS_IDLE
+#define OS_TICKLESS_IDLE            0
+#endif
+
+//   <q>Thread CPU usage accounting
+//   <i> Accumulates the CPU time of each thread and the CPU load.
+#ifndef OS_CPU_USAGE
+#define OS_CPU_USAGE                0
+#endif
+
+//   <o>Global Dynamic Memory size [bytes] <0-1073741824:8>
+//   <i> Defines the size of the heap used for objects created without
+//   <i> user provided memory, that do not fit an object specific pool.
+//   <i> Default: 0 (no heap)
+#ifndef OS_DYNAMIC_MEM_SIZE
+#define OS_DYNAMIC_MEM_SIZE         0
+#endif
+
+// </h>
+
+// <h>Thread Configuration
+// =======================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Thread Control Blocks and default stacks from their own pools.
+#ifndef OS_THREAD_OBJ_MEM
+#define OS_THREAD_OBJ_MEM           0
+#endif
+
+//     <o>Number of user Threads <1-1000>
+//     <i> Defines maximum number of user threads that can be active at the same time.
+#ifndef OS_THREAD_NUM
+#define OS_THREAD_NUM               1
+#endif
+
+//     <o>Number of user Threads with default Stack size <0-1000>
+//     <i> Defines maximum number of user threads with default stack size.
+#ifndef OS_THREAD_DEF_STACK_NUM
+#define OS_THREAD_DEF_STACK_NUM     0
+#endif
+
+//   </e>
+
+//   <o>Default Thread Stack size [bytes] <96-1073741824:8>
+//   <i> Defines stack size for threads with zero stack size specified.
+//   <i> Default: 256
+#ifndef OS_STACK_SIZE
+#define OS_STACK_SIZE               256
+#endif
+
+//   <o>Idle Thread Stack size [bytes] <72-1073741824:8>
+//   <i> Defines stack size for Idle thread.
+//   <i> Default: 256
+#ifndef OS_IDLE_THREAD_STACK_SIZE
+#define OS_IDLE_THREAD_STACK_SIZE   256
+#endif
+
+//   <q>Stack overrun checking
+//   <i> Enables stack overrun check at thread switch (GCC Cortex-M, GCC ARM7 and POSIX ports).
+//   <i> Enabling this option increases slightly the execution time of a thread switch.
+#ifndef OS_STACK_CHECK
+#define OS_STACK_CHECK              0
+#endif
+
+//   <q>Stack usage watermark
+//   <i> Initializes thread stack with watermark pattern for analyzing stack usage.
+//   <i> Enabling this option increases significantly the execution time of thread creation.
+#ifndef OS_STACK_WATERMARK
+#define OS_STACK_WATERMARK          0
+#endif
+
+//   <o>Processor mode for Thread execution
+//     <0=> Unprivileged mode
+//     <1=> Privileged mode
+//   <i> Default: Privileged mode
+#ifndef OS_PRIVILEGE_MODE
+#define OS_PRIVILEGE_MODE           1
+#endif
+
+// </h>
+
+// <h>Timer Configuration
+// ======================
+
+//   <o>Timer Thread Priority
+//      <2=> Low <7=> Below Normal  <12=> Normal  <17=> Above Normal <22=> High <27=> Realtime
+//   <i> Defines priority for timer thread
+//   <i> Default: High
+#ifndef OS_TIMER_THREAD_PRIO
+#define OS_TIMER_THREAD_PRIO        22
+#endif
+
+//   <o>Timer Thread Stack size [bytes] <0-1073741824:8>
+//   <i> Defines stack size for Timer thread.
+//   <i> Default: 256
+#ifndef OS_TIMER_THREAD_STACK_SIZE
+#define OS_TIMER_THREAD_STACK_SIZE  256
+#endif
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Timer Control Blocks from their own pool.
+#ifndef OS_TIMER_OBJ_MEM
+#define OS_TIMER_OBJ_MEM            0
+#endif
+
+//     <o>Number of Timer objects <1-1000>
+#ifndef OS_TIMER_NUM
+#define OS_TIMER_NUM                1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Event Flags Configuration
+// ============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Event Flags Control Blocks from their own pool.
+#ifndef OS_EVFLAGS_OBJ_MEM
+#define OS_EVFLAGS_OBJ_MEM          0
+#endif
+
+//     <o>Number of Event Flags objects <1-1000>
+#ifndef OS_EVFLAGS_NUM
+#define OS_EVFLAGS_NUM              1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Mutex Configuration
+// ======================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Mutex Control Blocks from their own pool.
+#ifndef OS_MUTEX_OBJ_MEM
+#define OS_MUTEX_OBJ_MEM            0
+#endif
+
+//     <o>Number of Mutex objects <1-1000>
+#ifndef OS_MUTEX_NUM
+#define OS_MUTEX_NUM                1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Semaphore Configuration
+// ==========================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Semaphore Control Blocks from their own pool.
+#ifndef OS_SEMAPHORE_OBJ_MEM
+#define OS_SEMAPHORE_OBJ_MEM        0
+#endif
+
+//     <o>Number of Semaphore objects <1-1000>
+#ifndef OS_SEMAPHORE_NUM
+#define OS_SEMAPHORE_NUM            1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Memory Pool Configuration
+// ============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Memory Pool Control Blocks from their own pool.
+#ifndef OS_MEMPOOL_OBJ_MEM
+#define OS_MEMPOOL_OBJ_MEM          0
+#endif
+
+//     <o>Number of Memory Pool objects <1-1000>
+#ifndef OS_MEMPOOL_NUM
+#define OS_MEMPOOL_NUM              1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Message Queue Configuration
+// ==============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Message Queue Control Blocks from their own pool.
+#ifndef OS_MSGQUEUE_OBJ_MEM
+#define OS_MSGQUEUE_OBJ_MEM         0
+#endif
+
+//     <o>Number of Message Queue objects <1-1000>
+#ifndef OS_MSGQUEUE_NUM
+#define OS_MSGQUEUE_NUM             1
+#endif
+
+//   </e>
+
+// </h>
+
+//------------- <<< end of configuration section >>> ---------------------------
+
+#endif  /* _KERNEL_CONFIG_H_ */
+
+/* ----------------------------- End of file ---------------------------------*/
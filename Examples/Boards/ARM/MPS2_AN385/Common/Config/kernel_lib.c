@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2019-2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ * Title:   Kernel Library Configuration
+ */
+
+#include "Kernel/kernel.h"
+#include "kernel_config.h"
+
+/* Idle Thread Control Block */
+static osThread_t os_idle_thread_cb __attribute__((section(".bss.os.thread.cb")));
+
+/* Idle Thread Stack */
+static uint64_t os_idle_thread_stack[OS_IDLE_THREAD_STACK_SIZE/8] __attribute__((section(".bss.os.thread.stack")));
+
+/* Idle Thread Attributes */
+static const osThreadAttr_t os_idle_thread_attr = {
+#if defined(OS_IDLE_THREAD_NAME)
+  OS_IDLE_THREAD_NAME,
+#else
+  NULL,
+#endif
+  osThreadDetached,
+  &os_idle_thread_cb,
+  (uint32_t)sizeof(os_idle_thread_cb),
+  &os_idle_thread_stack[0],
+  (uint32_t)sizeof(os_idle_thread_stack),
+  osPriorityIdle,
+  0U,
+  0U,
+  0U,
+};
+
+/* Timer Thread Control Block */
+static osThread_t os_timer_thread_cb __attribute__((section(".bss.os.thread.cb")));
+
+/* Timer Thread Stack */
+static uint64_t os_timer_thread_stack[OS_TIMER_THREAD_STACK_SIZE/8] __attribute__((section(".bss.os.thread.stack")));
+
+/* Timer Thread Attributes */
+static const osThreadAttr_t os_timer_thread_attr = {
+#if defined(OS_TIMER_THREAD_NAME)
+  OS_TIMER_THREAD_NAME,
+#else
+  NULL,
+#endif
+  osThreadDetached,
+  &os_timer_thread_cb,
+  (uint32_t)sizeof(os_timer_thread_cb),
+  &os_timer_thread_stack[0],
+  (uint32_t)sizeof(os_timer_thread_stack),
+  osPriorityISR,
+  0U,
+  0U,
+  0U,
+};
+
+#if (OS_THREAD_OBJ_MEM != 0)
+/* Thread Control Blocks */
+static osThread_t os_thread_cb[OS_THREAD_NUM] __attribute__((section(".bss.os.thread.cb")));
+
+/* Thread Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_thread = {
+  (uint32_t)OS_THREAD_NUM, 0U, (uint32_t)sizeof(osThread_t), &os_thread_cb[0], NULL, NULL
+};
+
+#if (OS_THREAD_DEF_STACK_NUM != 0)
+/* Default Thread Stacks */
+static uint64_t os_thread_def_stack[OS_THREAD_DEF_STACK_NUM*(OS_STACK_SIZE/8)] __attribute__((section(".bss.os.thread.stack")));
+
+/* Default Thread Stack Memory Pool */
+static osMemoryPoolInfo_t os_mpi_def_stack = {
+  (uint32_t)OS_THREAD_DEF_STACK_NUM, 0U, (uint32_t)OS_STACK_SIZE, &os_thread_def_stack[0], NULL, NULL
+};
+#endif
+#endif
+
+#if (OS_TIMER_OBJ_MEM != 0)
+/* Timer Control Blocks */
+static osTimer_t os_timer_cb[OS_TIMER_NUM];
+
+/* Timer Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_timer = {
+  (uint32_t)OS_TIMER_NUM, 0U, (uint32_t)sizeof(osTimer_t), &os_timer_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_EVFLAGS_OBJ_MEM != 0)
+/* Event Flags Control Blocks */
+static osEventFlags_t os_evflags_cb[OS_EVFLAGS_NUM];
+
+/* Event Flags Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_evflags = {
+  (uint32_t)OS_EVFLAGS_NUM, 0U, (uint32_t)sizeof(osEventFlags_t), &os_evflags_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_MUTEX_OBJ_MEM != 0)
+/* Mutex Control Blocks */
+static osMutex_t os_mutex_cb[OS_MUTEX_NUM];
+
+/* Mutex Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_mutex = {
+  (uint32_t)OS_MUTEX_NUM, 0U, (uint32_t)sizeof(osMutex_t), &os_mutex_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_SEMAPHORE_OBJ_MEM != 0)
+/* Semaphore Control Blocks */
+static osSemaphore_t os_semaphore_cb[OS_SEMAPHORE_NUM];
+
+/* Semaphore Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_semaphore = {
+  (uint32_t)OS_SEMAPHORE_NUM, 0U, (uint32_t)sizeof(osSemaphore_t), &os_semaphore_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_MEMPOOL_OBJ_MEM != 0)
+/* Memory Pool Control Blocks */
+static osMemoryPool_t os_mempool_cb[OS_MEMPOOL_NUM];
+
+/* Memory Pool Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_mempool = {
+  (uint32_t)OS_MEMPOOL_NUM, 0U, (uint32_t)sizeof(osMemoryPool_t), &os_mempool_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_MSGQUEUE_OBJ_MEM != 0)
+/* Message Queue Control Blocks */
+static osMessageQueue_t os_msgqueue_cb[OS_MSGQUEUE_NUM];
+
+/* Message Queue Control Block Pool */
+static osMemoryPoolInfo_t os_mpi_msgqueue = {
+  (uint32_t)OS_MSGQUEUE_NUM, 0U, (uint32_t)sizeof(osMessageQueue_t), &os_msgqueue_cb[0], NULL, NULL
+};
+#endif
+
+#if (OS_DYNAMIC_MEM_SIZE != 0)
+/* Global Dynamic Memory Heap */
+static osHeap_t os_heap_cb;
+
+/* Global Dynamic Memory */
+static uint64_t os_heap_mem[OS_DYNAMIC_MEM_SIZE/8];
+#endif
+
+const osConfig_t osConfig __attribute__((section(".rodata"))) = {
+  0U     // Flags
+#if (OS_PRIVILEGE_MODE != 0)
+  | osConfigPrivilegedMode
+#endif
+#if (OS_STACK_CHECK != 0)
+  | osConfigStackCheck
+#endif
+#if (OS_STACK_WATERMARK != 0)
+  | osConfigStackWatermark
+#endif
+#if (OS_TICKLESS_IDLE != 0)
+  | osConfigTicklessIdle
+#endif
+#if (OS_CPU_USAGE != 0)
+  | osConfigCpuUsage
+#endif
+  ,
+  (uint32_t)OS_TICK_FREQ,
+#if (OS_ROBIN_ENABLE != 0)
+  (uint32_t)OS_ROBIN_TIMEOUT,
+#else
+  0U,
+#endif
+  &os_idle_thread_attr,
+  &os_timer_thread_attr,
+  (uint32_t)OS_STACK_SIZE,
+  {
+#if ((OS_THREAD_OBJ_MEM != 0) && (OS_THREAD_DEF_STACK_NUM != 0))
+    &os_mpi_def_stack,
+#else
+    NULL,
+#endif
+#if (OS_THREAD_OBJ_MEM != 0)
+    &os_mpi_thread,
+#else
+    NULL,
+#endif
+#if (OS_TIMER_OBJ_MEM != 0)
+    &os_mpi_timer,
+#else
+    NULL,
+#endif
+#if (OS_EVFLAGS_OBJ_MEM != 0)
+    &os_mpi_evflags,
+#else
+    NULL,
+#endif
+#if (OS_MUTEX_OBJ_MEM != 0)
+    &os_mpi_mutex,
+#else
+    NULL,
+#endif
+#if (OS_SEMAPHORE_OBJ_MEM != 0)
+    &os_mpi_semaphore,
+#else
+    NULL,
+#endif
+#if (OS_MEMPOOL_OBJ_MEM != 0)
+    &os_mpi_mempool,
+#else
+    NULL,
+#endif
+#if (OS_MSGQUEUE_OBJ_MEM != 0)
+    &os_mpi_msgqueue,
+#else
+    NULL,
+#endif
+  },
+  {
+#if (OS_DYNAMIC_MEM_SIZE != 0)
+    &os_heap_cb,
+    &os_heap_mem[0],
+    (uint32_t)OS_DYNAMIC_MEM_SIZE,
+#else
+    NULL,
+    NULL,
+    0U,
+#endif
+  },
+};
+
+/* Non weak reference to library irq module */
+extern       uint8_t  irqLib;
+extern const uint8_t *irqLibRef;
+       const uint8_t *irqLibRef = &irqLib;
+
+/* ----------------------------- End of file ---------------------------------*/
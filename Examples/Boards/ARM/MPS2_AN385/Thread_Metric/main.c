@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Thread-Metric benchmark on the Arm MPS2 AN385 (Cortex-M3) board.
+ *
+ * The results are printed on UART0. The benchmark interrupt is the unused
+ * interrupt 31, pended by software.
+ *
+ * Build:
+ *   arm-none-eabi-gcc -mcpu=cortex-m3 -mthumb -O2 -ffunction-sections \
+ *      -IInclude -IDevice/ARM/CMSDK_CM3/Include \
+ *      -IExamples/Boards/ARM/MPS2_AN385/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/GCC/irq_cm3.S \
+ *      Examples/Boards/ARM/MPS2_AN385/Common/Config/[a-z]*.c \
+ *      Device/ARM/CMSDK_CM3/Startup/[a-z]*.c \
+ *      Middleware/Benchmark/thread_metric.c \
+ *      Examples/Boards/ARM/MPS2_AN385/Thread_Metric/main.c \
+ *      -T Device/ARM/CMSDK_CM3/Startup/gcc/CMSDK_CM3_gcc.ld \
+ *      --specs=nano.specs --specs=nosys.specs -Wl,--gc-sections \
+ *      -o thread_metric.elf
+ *
+ * Run under QEMU:
+ *   qemu-system-arm -M mps2-an385 -nographic -kernel thread_metric.elf
+ *
+ * QEMU does not model the instruction timing, so the numbers only compare
+ * kernel paths with each other. Use a real board for absolute figures.
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "asm/CMSDK_CM3.h"
+#include "Kernel/kernel.h"
+#include "Benchmark/thread_metric.h"
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (1024U)
+#define PRINTF_BUF_SIZE               (128U)
+
+#define UART                          CMSDK_UART0
+#define UART_BAUDRATE                 (115200U)
+
+#define BENCH_IRQn                    IRQ31_IRQn
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+static int32_t BenchPrintf(const char *format, ...);
+static void    BenchIrqTrigger(void);
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t thrd_main;
+static osThread_t   thrd_main_cb;
+static uint64_t     thrd_main_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_main_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_main_cb,
+    .cb_size    = sizeof(thrd_main_cb),
+    .stack_mem  = &thrd_main_stack[0],
+    .stack_size = sizeof(thrd_main_stack),
+    .priority   = osPriorityNormal,
+};
+
+static ThreadMetricPort_t bench_port = {
+    BenchPrintf,
+    BenchIrqTrigger,
+    1000U,
+};
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void UART_Initialize(void)
+{
+  UART->BAUDDIV = SystemCoreClock / UART_BAUDRATE;
+  UART->CTRL    = CMSDK_UART_CTRL_TXEN_Msk;
+}
+
+static void UART_PutChar(char ch)
+{
+  while ((UART->STATE & CMSDK_UART_STATE_TXBF_Msk) != 0U);
+  UART->DATA = (uint32_t)ch;
+}
+
+static int32_t BenchPrintf(const char *format, ...)
+{
+  char    buf[PRINTF_BUF_SIZE];
+  va_list args;
+  int     ret;
+
+  va_start(args, format);
+  ret = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+
+  for (const char *p = buf; *p != '\0'; p++) {
+    if (*p == '\n') {
+      UART_PutChar('\r');
+    }
+    UART_PutChar(*p);
+  }
+
+  return ((int32_t)ret);
+}
+
+static void BenchIrqTrigger(void)
+{
+  NVIC_SetPendingIRQ(BENCH_IRQn);
+}
+
+static void thrd_main_func(void *argument)
+{
+  (void) argument;
+
+  ThreadMetricRun(&bench_port);
+
+  for (;;) {
+    osDelay(osWaitForever);
+  }
+}
+
+/*******************************************************************************
+ *  function implementations (scope: module-exported)
+ ******************************************************************************/
+
+void IRQ31_IRQHandler(void)
+{
+  ThreadMetricIrqHandler();
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  UART_Initialize();
+
+  NVIC_SetPriority(BENCH_IRQn, (1UL << __NVIC_PRIO_BITS) - 2UL);
+  NVIC_EnableIRQ(BENCH_IRQn);
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_main = osThreadNew(thrd_main_func, NULL, &thrd_main_attr);
+    if (thrd_main == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Timed wait latency on the POSIX host port.
+ *
+ * NUM_WAITERS threads block on a semaphore with long random timeouts. The
+ * measuring thread then enters a timed wait with a random timeout and is
+ * woken at once by a lower priority thread: every round trip inserts into
+ * and cancels from the thread delay list. The average and the worst-case
+ * round trip times are reported.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Delay_Bench/main.c -o delay_bench
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define WAITER_STACK_SIZE             (16384U)
+#define NUM_WAITERS                   (256U)
+#define NUM_ROUNDS                    (100000U)
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t thrd_a;
+static osThread_t   thrd_a_cb;
+static uint64_t     thrd_a_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_a_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_a_cb,
+    .cb_size    = sizeof(thrd_a_cb),
+    .stack_mem  = &thrd_a_stack[0],
+    .stack_size = sizeof(thrd_a_stack),
+    .priority   = osPriorityHigh,
+};
+
+static osThreadId_t thrd_b;
+static osThread_t   thrd_b_cb;
+static uint64_t     thrd_b_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_b_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_b_cb,
+    .cb_size    = sizeof(thrd_b_cb),
+    .stack_mem  = &thrd_b_stack[0],
+    .stack_size = sizeof(thrd_b_stack),
+    .priority   = osPriorityNormal,
+};
+
+static osThread_t   waiter_cb[NUM_WAITERS];
+static uint64_t     waiter_stack[NUM_WAITERS][WAITER_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t waiter_attr;
+
+static osSemaphoreId_t sem;
+static osSemaphore_t   sem_cb;
+static const osSemaphoreAttr_t sem_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &sem_cb,
+    .cb_size    = sizeof(sem_cb),
+};
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void waiter_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    osSemaphoreAcquire(sem, 10000U + ((uint32_t)rand() % 50000U));
+  }
+}
+
+static void thrd_a_func(void *argument)
+{
+  uint32_t start;
+  uint32_t time;
+  uint32_t time_max;
+  uint64_t time_sum;
+  uint32_t freq;
+  (void) argument;
+
+  /* Let the waiters block */
+  osDelay(10U);
+
+  time_max = 0U;
+  time_sum = 0U;
+
+  for (uint32_t i = 0U; i < NUM_ROUNDS; i++) {
+    start = osKernelGetSysTimerCount();
+    osThreadFlagsWait(1U, osFlagsWaitAny, 1U + ((uint32_t)rand() % 60000U));
+    time = osKernelGetSysTimerCount() - start;
+    time_sum += time;
+    if (time > time_max) {
+      time_max = time;
+    }
+  }
+
+  freq = osKernelGetSysTimerFreq();
+  printf("%u timed waiters, timed wait round trip: %u ns average, %u ns max\n", NUM_WAITERS,
+         (uint32_t)((time_sum * (1000000000U / freq)) / NUM_ROUNDS),
+         (uint32_t)(((uint64_t)time_max * (1000000000U / freq))));
+
+  exit(0);
+}
+
+static void thrd_b_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    osThreadFlagsSet(thrd_a, 1U);
+  }
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    sem = osSemaphoreNew(1U, 0U, &sem_attr);
+    if (sem == NULL) {
+      goto error;
+    }
+
+    for (uint32_t i = 0U; i < NUM_WAITERS; i++) {
+      waiter_attr.cb_mem     = &waiter_cb[i];
+      waiter_attr.cb_size    = sizeof(waiter_cb[i]);
+      waiter_attr.stack_mem  = &waiter_stack[i][0];
+      waiter_attr.stack_size = sizeof(waiter_stack[i]);
+      waiter_attr.priority   = osPriorityAboveNormal;
+      if (osThreadNew(waiter_func, NULL, &waiter_attr) == NULL) {
+        goto error;
+      }
+    }
+
+    thrd_a = osThreadNew(thrd_a_func, NULL, &thrd_a_attr);
+    if (thrd_a == NULL) {
+      goto error;
+    }
+
+    thrd_b = osThreadNew(thrd_b_func, NULL, &thrd_b_attr);
+    if (thrd_b == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Dispatch cost of EDF threads against fixed priority threads on the POSIX
+ * host port.
+ *
+ * A waker thread sets a thread flag of a sleeper thread, which preempts it
+ * and waits for the flag again. The sleeper runs either at a higher priority
+ * or at the same priority with an earlier deadline. Background threads of
+ * the same priority with later deadlines stay ready in the EDF run.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/EDF_Bench/main.c -o edf_bench
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_ROUNDS                    (500000U)
+#define NUM_BACKGROUND                (8U)
+
+#define FLAG_WAKE                     (1U << 0)
+#define FLAG_DONE                     (1U << 1)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef struct {
+  osThread_t  cb;
+  uint64_t    stack[THREAD_STACK_SIZE/8U];
+} BenchThread_t;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t  thrd_main;
+static BenchThread_t thrd_main_mem __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_main_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_main_mem.cb,
+    .cb_size    = sizeof(thrd_main_mem.cb),
+    .stack_mem  = &thrd_main_mem.stack[0],
+    .stack_size = sizeof(thrd_main_mem.stack),
+    .priority   = osPriorityRealtime,
+};
+
+static BenchThread_t  thrd_mem[2U + NUM_BACKGROUND] __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_attr[2U + NUM_BACKGROUND];
+static osThreadId_t   thrd_id[2U + NUM_BACKGROUND];
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void sleeper_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    osThreadFlagsWait(FLAG_WAKE, osFlagsWaitAny, osWaitForever);
+  }
+}
+
+static void waker_func(void *argument)
+{
+  osThreadId_t sleeper = (osThreadId_t)argument;
+
+  for (uint32_t i = 0U; i < NUM_ROUNDS; i++) {
+    osThreadFlagsSet(sleeper, FLAG_WAKE);
+  }
+
+  osThreadFlagsSet(thrd_main, FLAG_DONE);
+
+  for (;;) {
+    osThreadSuspend(osThreadGetId());
+  }
+}
+
+static void background_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    osThreadYield();
+  }
+}
+
+static osThreadId_t ThreadCreate(uint32_t idx, osThreadFunc_t func, void *argument,
+                                 osPriority_t priority, uint32_t deadline)
+{
+  thrd_attr[idx].cb_mem     = &thrd_mem[idx].cb;
+  thrd_attr[idx].cb_size    = sizeof(thrd_mem[idx].cb);
+  thrd_attr[idx].stack_mem  = &thrd_mem[idx].stack[0];
+  thrd_attr[idx].stack_size = sizeof(thrd_mem[idx].stack);
+  thrd_attr[idx].priority   = priority;
+  thrd_attr[idx].deadline   = deadline;
+
+  thrd_id[idx] = osThreadNew(func, argument, &thrd_attr[idx]);
+
+  return (thrd_id[idx]);
+}
+
+static void BenchRun(const char *name, bool edf, uint32_t background)
+{
+  uint32_t start;
+  uint32_t time;
+  uint32_t count = 2U;
+
+  if (edf) {
+    ThreadCreate(0U, sleeper_func, NULL, osPriorityNormal, 10U);
+    for (uint32_t i = 0U; i < background; i++) {
+      ThreadCreate(count++, background_func, NULL, osPriorityNormal, 200000U + i);
+    }
+  }
+  else {
+    ThreadCreate(0U, sleeper_func, NULL, osPriorityAboveNormal, 0U);
+  }
+
+  start = osKernelGetSysTimerCount();
+  ThreadCreate(1U, waker_func, thrd_id[0], osPriorityNormal, edf ? 100000U : 0U);
+  osThreadFlagsWait(FLAG_DONE, osFlagsWaitAny, osWaitForever);
+  time = osKernelGetSysTimerCount() - start;
+
+  for (uint32_t i = 0U; i < count; i++) {
+    osThreadTerminate(thrd_id[i]);
+  }
+
+  printf("%-34s %6u ns per wakeup\n", name,
+         (uint32_t)(((uint64_t)time * (1000000000U / osKernelGetSysTimerFreq())) / NUM_ROUNDS));
+}
+
+static void thrd_main_func(void *argument)
+{
+  (void) argument;
+
+  BenchRun("Fixed priority",                false, 0U);
+  BenchRun("EDF",                           true,  0U);
+  BenchRun("EDF, 8 later deadlines ready",  true,  NUM_BACKGROUND);
+
+  exit(0);
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_main = osThreadNew(thrd_main_func, NULL, &thrd_main_attr);
+    if (thrd_main == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
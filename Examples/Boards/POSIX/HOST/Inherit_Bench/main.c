@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Priority inversion latency through a chain of nested mutexes on the POSIX
+ * host port.
+ *
+ * A low priority thread holds mutex 0 for LOCK_TIME_MS. Each of the next
+ * NUM_MUTEXES-1 threads, one priority level higher than the previous one,
+ * holds mutex n and waits for mutex n-1. A high priority thread then waits
+ * for the last mutex while a normal priority thread spins for HOG_TIME_MS.
+ * The high priority thread gets its mutex only after the low priority
+ * thread runs, so the boost has to reach the end of the chain, otherwise
+ * the spinning thread delays the high priority thread.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Inherit_Bench/main.c -o inherit_bench
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_ROUNDS                    (5U)
+#define NUM_MUTEXES                   (3U)
+
+#define THREAD_HOG                    (NUM_MUTEXES)
+#define THREAD_HIGH                   (NUM_MUTEXES + 1U)
+#define THREAD_NUM                    (NUM_MUTEXES + 2U)
+#define LOCK_TIME_MS                  (10U)
+#define HOG_TIME_MS                   (50U)
+
+#define FLAG_DONE                     (1U << 0)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef struct {
+  osThread_t  cb;
+  uint64_t    stack[THREAD_STACK_SIZE/8U];
+} BenchThread_t;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t  thrd_main;
+static BenchThread_t thrd_main_mem __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_main_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_main_mem.cb,
+    .cb_size    = sizeof(thrd_main_mem.cb),
+    .stack_mem  = &thrd_main_mem.stack[0],
+    .stack_size = sizeof(thrd_main_mem.stack),
+    .priority   = osPriorityRealtime,
+};
+
+static BenchThread_t  thrd_mem[THREAD_NUM] __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_attr[THREAD_NUM];
+static osThreadId_t   thrd_id[THREAD_NUM];
+
+static osMutex_t      mutex_mem[NUM_MUTEXES];
+static osMutexId_t    mutex_id[NUM_MUTEXES];
+
+static uint32_t       wait_start;
+static uint32_t       wait_time;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void Spin(uint32_t ms)
+{
+  uint32_t start = osKernelGetSysTimerCount();
+  uint32_t count = (osKernelGetSysTimerFreq() / 1000U) * ms;
+
+  while ((osKernelGetSysTimerCount() - start) < count) {
+  }
+}
+
+static void low_func(void *argument)
+{
+  (void) argument;
+
+  osMutexAcquire(mutex_id[0], osWaitForever);
+  Spin(LOCK_TIME_MS);
+  osMutexRelease(mutex_id[0]);
+
+  osThreadExit();
+}
+
+static void mid_func(void *argument)
+{
+  uint32_t n = (uint32_t)(uintptr_t)argument;
+
+  osMutexAcquire(mutex_id[n], osWaitForever);
+  osMutexAcquire(mutex_id[n - 1U], osWaitForever);
+  osMutexRelease(mutex_id[n - 1U]);
+  osMutexRelease(mutex_id[n]);
+
+  osThreadExit();
+}
+
+static void hog_func(void *argument)
+{
+  (void) argument;
+
+  Spin(HOG_TIME_MS);
+
+  osThreadExit();
+}
+
+static void high_func(void *argument)
+{
+  (void) argument;
+
+  wait_start = osKernelGetSysTimerCount();
+  osMutexAcquire(mutex_id[NUM_MUTEXES - 1U], osWaitForever);
+  wait_time = osKernelGetSysTimerCount() - wait_start;
+  osMutexRelease(mutex_id[NUM_MUTEXES - 1U]);
+
+  osThreadFlagsSet(thrd_main, FLAG_DONE);
+  osThreadExit();
+}
+
+static void ThreadCreate(uint32_t idx, osThreadFunc_t func, osPriority_t priority)
+{
+  thrd_attr[idx].cb_mem     = &thrd_mem[idx].cb;
+  thrd_attr[idx].cb_size    = sizeof(thrd_mem[idx].cb);
+  thrd_attr[idx].stack_mem  = &thrd_mem[idx].stack[0];
+  thrd_attr[idx].stack_size = sizeof(thrd_mem[idx].stack);
+  thrd_attr[idx].priority   = priority;
+
+  thrd_id[idx] = osThreadNew(func, (void *)(uintptr_t)idx, &thrd_attr[idx]);
+}
+
+static osMutexId_t MutexCreate(osMutex_t *mutex)
+{
+  osMutexAttr_t attr = {
+      .name      = NULL,
+      .attr_bits = osMutexPrioInherit,
+      .cb_mem    = mutex,
+      .cb_size   = sizeof(*mutex),
+  };
+
+  return (osMutexNew(&attr));
+}
+
+static uint32_t BenchRound(void)
+{
+  for (uint32_t n = 0U; n < NUM_MUTEXES; n++) {
+    mutex_id[n] = MutexCreate(&mutex_mem[n]);
+  }
+
+  /* Thread 0 takes mutex 0, then thread n takes mutex n and blocks on n-1 */
+  ThreadCreate(0U, low_func, osPriorityLow1);
+  osDelay(1U);
+  for (uint32_t n = 1U; n < NUM_MUTEXES; n++) {
+    ThreadCreate(n, mid_func, (osPriority_t)((uint32_t)osPriorityLow1 + n));
+    osDelay(1U);
+  }
+
+  /* High blocks on the last mutex while Hog is ready to run */
+  ThreadCreate(THREAD_HOG, hog_func, osPriorityNormal);
+  ThreadCreate(THREAD_HIGH, high_func, osPriorityHigh);
+  osThreadFlagsWait(FLAG_DONE, osFlagsWaitAny, osWaitForever);
+
+  /* Let the spinning thread finish */
+  osDelay(HOG_TIME_MS + 10U);
+
+  for (uint32_t n = 0U; n < NUM_MUTEXES; n++) {
+    osMutexDelete(mutex_id[n]);
+  }
+
+  return ((uint32_t)(((uint64_t)wait_time * 1000000U) / osKernelGetSysTimerFreq()));
+}
+
+static void thrd_main_func(void *argument)
+{
+  uint32_t time;
+  uint32_t worst = 0U;
+
+  (void) argument;
+
+  for (uint32_t i = 0U; i < NUM_ROUNDS; i++) {
+    time = BenchRound();
+    if (time > worst) {
+      worst = time;
+    }
+  }
+
+  printf("Chain of %u mutexes, %u ms lock, %u ms hog: worst wait %u us\n",
+         NUM_MUTEXES, LOCK_TIME_MS, HOG_TIME_MS, worst);
+
+  exit(0);
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_main = osThreadNew(thrd_main_func, NULL, &thrd_main_attr);
+    if (thrd_main == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
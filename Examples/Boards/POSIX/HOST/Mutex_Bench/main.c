@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cost of mutex acquire/release pairs on the POSIX host port.
+ *
+ * The uncontended runs lock and unlock a free mutex in a loop. The contended
+ * run has two threads of the same priority that yield while holding the
+ * mutex, so that every acquire blocks and every release hands the mutex
+ * over to the waiting thread.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Mutex_Bench/main.c -o mutex_bench
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_ROUNDS                    (2000000U)
+#define NUM_ROUNDS_CONTENDED          (200000U)
+
+#define FLAG_DONE                     (1U << 0)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef struct {
+  osThread_t  cb;
+  uint64_t    stack[THREAD_STACK_SIZE/8U];
+} BenchThread_t;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t  thrd_main;
+static BenchThread_t thrd_main_mem __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_main_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_main_mem.cb,
+    .cb_size    = sizeof(thrd_main_mem.cb),
+    .stack_mem  = &thrd_main_mem.stack[0],
+    .stack_size = sizeof(thrd_main_mem.stack),
+    .priority   = osPriorityRealtime,
+};
+
+static BenchThread_t  thrd_mem[2U] __attribute__((section(".bss.os.thread.stack")));
+static osThreadAttr_t thrd_attr[2U];
+static osThreadId_t   thrd_id[2U];
+
+static osMutex_t      mutex_mem;
+static osMutexId_t    mutex_id;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void contender_func(void *argument)
+{
+  (void) argument;
+
+  for (uint32_t i = 0U; i < NUM_ROUNDS_CONTENDED; i++) {
+    osMutexAcquire(mutex_id, osWaitForever);
+    osThreadYield();
+    osMutexRelease(mutex_id);
+  }
+
+  osThreadFlagsSet(thrd_main, FLAG_DONE);
+
+  for (;;) {
+    osThreadSuspend(osThreadGetId());
+  }
+}
+
+static void MutexCreate(uint32_t attr_bits)
+{
+  osMutexAttr_t attr = {
+      .name      = NULL,
+      .attr_bits = attr_bits,
+      .cb_mem    = &mutex_mem,
+      .cb_size   = sizeof(mutex_mem),
+  };
+
+  mutex_id = osMutexNew(&attr);
+}
+
+static void BenchReport(const char *name, uint32_t time, uint32_t rounds)
+{
+  printf("%-34s %6u ns per acquire/release\n", name,
+         (uint32_t)(((uint64_t)time * (1000000000U / osKernelGetSysTimerFreq())) / rounds));
+}
+
+static void BenchUncontended(const char *name, uint32_t attr_bits, uint32_t depth)
+{
+  uint32_t start;
+  uint32_t time;
+
+  MutexCreate(attr_bits);
+
+  start = osKernelGetSysTimerCount();
+  for (uint32_t i = 0U; i < NUM_ROUNDS; i++) {
+    for (uint32_t n = 0U; n < depth; n++) {
+      osMutexAcquire(mutex_id, osWaitForever);
+    }
+    for (uint32_t n = 0U; n < depth; n++) {
+      osMutexRelease(mutex_id);
+    }
+  }
+  time = osKernelGetSysTimerCount() - start;
+
+  osMutexDelete(mutex_id);
+
+  BenchReport(name, time, NUM_ROUNDS * depth);
+}
+
+static void BenchContended(const char *name, uint32_t attr_bits)
+{
+  uint32_t start;
+  uint32_t time;
+
+  MutexCreate(attr_bits);
+
+  start = osKernelGetSysTimerCount();
+  for (uint32_t i = 0U; i < 2U; i++) {
+    thrd_attr[i].cb_mem     = &thrd_mem[i].cb;
+    thrd_attr[i].cb_size    = sizeof(thrd_mem[i].cb);
+    thrd_attr[i].stack_mem  = &thrd_mem[i].stack[0];
+    thrd_attr[i].stack_size = sizeof(thrd_mem[i].stack);
+    thrd_attr[i].priority   = osPriorityNormal;
+    thrd_id[i] = osThreadNew(contender_func, NULL, &thrd_attr[i]);
+  }
+  osThreadFlagsWait(FLAG_DONE, osFlagsWaitAll, osWaitForever);
+  osThreadFlagsWait(FLAG_DONE, osFlagsWaitAll, osWaitForever);
+  time = osKernelGetSysTimerCount() - start;
+
+  for (uint32_t i = 0U; i < 2U; i++) {
+    osThreadTerminate(thrd_id[i]);
+  }
+
+  osMutexDelete(mutex_id);
+
+  BenchReport(name, time, 2U * NUM_ROUNDS_CONTENDED);
+}
+
+static void thrd_main_func(void *argument)
+{
+  (void) argument;
+
+  BenchUncontended("Uncontended",                   0U,                1U);
+  BenchUncontended("Uncontended, inheritance",      osMutexPrioInherit, 1U);
+  BenchUncontended("Uncontended, recursive x2",     osMutexRecursive,  2U);
+  BenchUncontended("Uncontended, robust",           osMutexRobust,     1U);
+  BenchContended  ("Contended, inheritance",        osMutexPrioInherit);
+
+  exit(0);
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_main = osThreadNew(thrd_main_func, NULL, &thrd_main_attr);
+    if (thrd_main == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
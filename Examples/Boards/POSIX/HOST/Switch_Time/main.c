@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Thread switch time on the POSIX host port.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Switch_Time/main.c -o switch_time
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_SWITCHES                  (1000000U)
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t thrd_a;
+static osThread_t   thrd_a_cb;
+static uint64_t     thrd_a_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_a_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_a_cb,
+    .cb_size    = sizeof(thrd_a_cb),
+    .stack_mem  = &thrd_a_stack[0],
+    .stack_size = sizeof(thrd_a_stack),
+    .priority   = osPriorityNormal,
+};
+
+static osThreadId_t thrd_b;
+static osThread_t   thrd_b_cb;
+static uint64_t     thrd_b_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_b_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_b_cb,
+    .cb_size    = sizeof(thrd_b_cb),
+    .stack_mem  = &thrd_b_stack[0],
+    .stack_size = sizeof(thrd_b_stack),
+    .priority   = osPriorityNormal,
+};
+
+static volatile uint32_t switches;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void thrd_a_func(void *argument)
+{
+  uint32_t start;
+  uint32_t time;
+  (void) argument;
+
+  start = osKernelGetSysTimerCount();
+  while (switches < NUM_SWITCHES) {
+    switches++;
+    osThreadYield();
+  }
+  time = osKernelGetSysTimerCount() - start;
+
+  printf("%u thread switches, %u ns per switch\n", switches,
+         (uint32_t)(((uint64_t)time * (1000000000U / osKernelGetSysTimerFreq())) / switches));
+
+  exit(0);
+}
+
+static void thrd_b_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    switches++;
+    osThreadYield();
+  }
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_a = osThreadNew(thrd_a_func, NULL, &thrd_a_attr);
+    if (thrd_a == NULL) {
+      goto error;
+    }
+
+    thrd_b = osThreadNew(thrd_b_func, NULL, &thrd_b_attr);
+    if (thrd_b == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Thread-Metric benchmark on the POSIX host port.
+ *
+ * The benchmark interrupt is emulated with IRQ_Call. Cycles are nanoseconds.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Middleware/Benchmark/thread_metric.c \
+ *      Examples/Boards/POSIX/HOST/Thread_Metric/main.c -o thread_metric
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+#include <Benchmark/thread_metric.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+static int32_t BenchPrintf(const char *format, ...);
+static void    BenchIrqTrigger(void);
+
+/* POSIX port */
+extern void IRQ_Call(void (*handler)(void));
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t thrd_main;
+static osThread_t   thrd_main_cb;
+static uint64_t     thrd_main_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_main_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_main_cb,
+    .cb_size    = sizeof(thrd_main_cb),
+    .stack_mem  = &thrd_main_stack[0],
+    .stack_size = sizeof(thrd_main_stack),
+    .priority   = osPriorityNormal,
+};
+
+static ThreadMetricPort_t bench_port = {
+    BenchPrintf,
+    BenchIrqTrigger,
+    1000U,
+};
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static int32_t BenchPrintf(const char *format, ...)
+{
+  va_list args;
+  int     ret;
+
+  va_start(args, format);
+  ret = vprintf(format, args);
+  va_end(args);
+
+  return ((int32_t)ret);
+}
+
+static void BenchIrqTrigger(void)
+{
+  IRQ_Call(ThreadMetricIrqHandler);
+}
+
+static void thrd_main_func(void *argument)
+{
+  (void) argument;
+
+  ThreadMetricRun(&bench_port);
+
+  exit(0);
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    thrd_main = osThreadNew(thrd_main_func, NULL, &thrd_main_attr);
+    if (thrd_main == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
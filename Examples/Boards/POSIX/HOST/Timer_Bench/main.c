@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Software timer start/stop cost on the POSIX host port.
+ *
+ * NUM_TIMERS one-shot timers are restarted or stopped at random with random
+ * intervals, the way protocol retransmit timers are. Expired timers report
+ * the difference between the expiration tick and the requested one.
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Timer_Bench/main.c -o timer_bench
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_TIMERS                    (512U)
+#define NUM_ROUNDS                    (200U)
+#define OPS_PER_ROUND                 (2000U)
+#define MAX_INTERVAL                  (2000U)
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t thrd;
+static osThread_t   thrd_cb;
+static uint64_t     thrd_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t thrd_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &thrd_cb,
+    .cb_size    = sizeof(thrd_cb),
+    .stack_mem  = &thrd_stack[0],
+    .stack_size = sizeof(thrd_stack),
+    .priority   = osPriorityNormal,
+};
+
+static osTimerId_t timer[NUM_TIMERS];
+static osTimer_t   timer_cb[NUM_TIMERS];
+static uint32_t    timer_due[NUM_TIMERS];
+static osTimerAttr_t timer_attr;
+
+static uint32_t expired;
+static uint32_t late_max;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void timer_func(void *argument)
+{
+  uint32_t late = osKernelGetTickCount() - timer_due[(uintptr_t)argument];
+
+  if (late > late_max) {
+    late_max = late;
+  }
+  expired++;
+}
+
+static void thrd_func(void *argument)
+{
+  uint32_t start;
+  uint32_t time;
+  uint32_t ops;
+  uint32_t i;
+  uint32_t ticks;
+  (void) argument;
+
+  srand(1U);
+  time = 0U;
+  ops  = 0U;
+
+  for (uint32_t round = 0U; round < NUM_ROUNDS; round++) {
+    for (uint32_t op = 0U; op < OPS_PER_ROUND; op++) {
+      i     = (uint32_t)rand() % NUM_TIMERS;
+      ticks = 1U + ((uint32_t)rand() % MAX_INTERVAL);
+
+      start = osKernelGetSysTimerCount();
+      if ((op & 3U) != 3U) {
+        timer_due[i] = osKernelGetTickCount() + ticks;
+        osTimerStart(timer[i], ticks);
+      }
+      else {
+        osTimerStop(timer[i]);
+      }
+      time += osKernelGetSysTimerCount() - start;
+      ops++;
+    }
+    osDelay(1U);
+  }
+
+  printf("%u timers, %u start/stop, %u ns per call, %u expired, max %u ticks late\n",
+         NUM_TIMERS, ops, (uint32_t)(((uint64_t)time * (1000000000U / osKernelGetSysTimerFreq())) / ops),
+         expired, late_max);
+
+  exit(0);
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    for (uintptr_t i = 0U; i < NUM_TIMERS; i++) {
+      timer_attr.cb_mem  = &timer_cb[i];
+      timer_attr.cb_size = sizeof(timer_cb[i]);
+      timer[i] = osTimerNew(timer_func, osTimerOnce, (void *)i, &timer_attr);
+      if (timer[i] == NULL) {
+        goto error;
+      }
+    }
+
+    thrd = osThreadNew(thrd_func, NULL, &thrd_attr);
+    if (thrd == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
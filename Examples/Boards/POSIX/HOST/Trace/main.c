@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Kernel event trace on the POSIX host port.
+ *
+ * A producer thread wakes a consumer thread through a semaphore every few
+ * ticks. The trace buffer is then written to trace.bin and can be converted
+ * to a timeline:
+ *   nm trace > trace.sym
+ *   trace2json -s trace.sym trace.bin > trace.json
+ *
+ * Build (64-bit host):
+ *   cc -O2 -no-pie -DOS_TRACE=1 -DOS_TRACE_SIZE=1024 \
+ *      -IInclude -IExamples/Boards/POSIX/HOST/Common/Config \
+ *      Kernel/Source/[a-z]*.c Kernel/Source/POSIX/irq_posix.c \
+ *      Examples/Boards/POSIX/HOST/Common/Config/[a-z]*.c \
+ *      Examples/Boards/POSIX/HOST/Trace/main.c -o trace
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Kernel/kernel.h>
+#include <Kernel/trace.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define THREAD_STACK_SIZE             (32768U)
+#define NUM_ROUNDS                    (20U)
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t producer;
+static osThread_t   producer_cb;
+static uint64_t     producer_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t producer_attr = {
+    .name       = "producer",
+    .attr_bits  = 0U,
+    .cb_mem     = &producer_cb,
+    .cb_size    = sizeof(producer_cb),
+    .stack_mem  = &producer_stack[0],
+    .stack_size = sizeof(producer_stack),
+    .priority   = osPriorityNormal,
+};
+
+static osThreadId_t consumer;
+static osThread_t   consumer_cb;
+static uint64_t     consumer_stack[THREAD_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+static const osThreadAttr_t consumer_attr = {
+    .name       = "consumer",
+    .attr_bits  = 0U,
+    .cb_mem     = &consumer_cb,
+    .cb_size    = sizeof(consumer_cb),
+    .stack_mem  = &consumer_stack[0],
+    .stack_size = sizeof(consumer_stack),
+    .priority   = osPriorityAboveNormal,
+};
+
+static osSemaphoreId_t sem;
+static osSemaphore_t   sem_cb;
+static const osSemaphoreAttr_t sem_attr = {
+    .name       = "sem",
+    .attr_bits  = 0U,
+    .cb_mem     = &sem_cb,
+    .cb_size    = sizeof(sem_cb),
+};
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static void TraceSave(const char *path)
+{
+  FILE       *file;
+  const void *buf;
+  uint32_t    size;
+
+  buf = osTraceGetBuffer(&size);
+  if (buf == NULL) {
+    printf("The kernel is built without OS_TRACE\n");
+    return;
+  }
+
+  file = fopen(path, "wb");
+  if (file != NULL) {
+    fwrite(buf, 1U, size, file);
+    fclose(file);
+    printf("%u events written to %s\n", ((const osTraceHeader_t *)buf)->count, path);
+  }
+}
+
+static void producer_func(void *argument)
+{
+  (void) argument;
+
+  for (uint32_t i = 0U; i < NUM_ROUNDS; i++) {
+    osDelay(1U + (i % 3U));
+    osSemaphoreRelease(sem);
+  }
+
+  osDelay(5U);
+  TraceSave("trace.bin");
+
+  exit(0);
+}
+
+static void consumer_func(void *argument)
+{
+  (void) argument;
+
+  for (;;) {
+    osSemaphoreAcquire(sem, osWaitForever);
+  }
+}
+
+int main(void)
+{
+  osStatus_t status;
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    sem = osSemaphoreNew(1U, 0U, &sem_attr);
+    if (sem == NULL) {
+      goto error;
+    }
+
+    producer = osThreadNew(producer_func, NULL, &producer_attr);
+    if (producer == NULL) {
+      goto error;
+    }
+
+    consumer = osThreadNew(consumer_func, NULL, &consumer_attr);
+    if (consumer == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
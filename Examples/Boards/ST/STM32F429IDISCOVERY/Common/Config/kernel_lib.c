@@ -48,6 +48,9 @@ static const osThreadAttr_t os_idle_thread_attr = {
   &os_idle_thread_stack[0],
   (uint32_t)sizeof(os_idle_thread_stack),
   osPriorityIdle,
+  0U,
+  0U,
+  0U,
 };
 
 /* Timer Thread Control Block */
@@ -69,6 +72,9 @@ static const osThreadAttr_t os_timer_thread_attr = {
   &os_timer_thread_stack[0],
   (uint32_t)sizeof(os_timer_thread_stack),
   osPriorityISR,
+  0U,
+  0U,
+  0U,
 };
 
 const osConfig_t osConfig __USED __attribute__((section(".rodata"))) = {
@@ -41,6 +41,7 @@ static const osThreadAttr_t threadA_attr = {
     .stack_mem  = &threadA_stack[0],
     .stack_size = sizeof(threadA_stack),
     .priority   = osPriorityNormal,
+    .time_slice = osThreadTimeSliceDefault,
 };
 
 static osThreadId_t         threadB;
@@ -54,6 +55,7 @@ static const osThreadAttr_t threadB_attr = {
     .stack_mem  = &threadB_stack[0],
     .stack_size = sizeof(threadB_stack),
     .priority   = osPriorityNormal,
+    .time_slice = osThreadTimeSliceDefault,
 };
 
 static osEventFlagsId_t         event;
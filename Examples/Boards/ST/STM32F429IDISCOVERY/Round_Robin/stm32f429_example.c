@@ -39,6 +39,7 @@ static const osThreadAttr_t threadA_attr = {
     .stack_mem  = &threadA_stack[0],
     .stack_size = sizeof(threadA_stack),
     .priority   = osPriorityNormal,
+    .time_slice = osThreadTimeSliceDefault,
 };
 
 static osThreadId_t         threadB;
@@ -52,6 +53,7 @@ static const osThreadAttr_t threadB_attr = {
     .stack_mem  = &threadB_stack[0],
     .stack_size = sizeof(threadB_stack),
     .priority   = osPriorityNormal,
+    .time_slice = osThreadTimeSliceDefault,
 };
 
 static const GPIO_PIN_CFG_t LED_cfg = {
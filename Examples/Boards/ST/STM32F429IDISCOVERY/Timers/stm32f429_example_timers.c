@@ -40,6 +40,7 @@ static const osThreadAttr_t init_attr = {
     .stack_mem  = &init_stack[0],
     .stack_size = sizeof(init_stack),
     .priority   = osPriorityNormal,
+    .time_slice = osThreadTimeSliceDefault,
 };
 
 static osTimerId_t         timer1;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Description: This file contains definitions for the Thread-Metric style
+ *              kernel benchmark.
+ */
+
+#ifndef THREAD_METRIC_H_
+#define THREAD_METRIC_H_
+
+#include <stdint.h>
+
+/// Board support of the benchmark.
+typedef struct ThreadMetricPort_s {
+  int32_t  (*printf)(const char *format, ...);  ///< Output of the results
+  void     (*IrqTrigger)(void);   ///< Pend the benchmark interrupt, NULL - skip the ISR test
+  uint32_t   duration;            ///< Duration of each test [ms], 0 - 1000 ms
+} const ThreadMetricPort_t;
+
+/**
+ * @brief       Run all tests and print the results.
+ * @param[in]   port  board support.
+ * @note        Must be called from a thread. The calling thread runs at
+ *              osPriorityRealtime until the tests are finished.
+ */
+void ThreadMetricRun(ThreadMetricPort_t *port);
+
+/**
+ * @brief       Benchmark interrupt handler, called by the board support from
+ *              the interrupt pended by IrqTrigger.
+ */
+void ThreadMetricIrqHandler(void);
+
+#endif /* THREAD_METRIC_H_ */
+
+/* ----------------------------- End of file ---------------------------------*/
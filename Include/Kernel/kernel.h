@@ -93,15 +93,24 @@ extern "C"
 #define osThreadDetached              0x00000000U ///< Thread created in detached mode (default)
 #define osThreadJoinable              0x00000001U ///< Thread created in joinable mode
 
+/* Thread round-robin time slice (time_slice in \ref osThreadAttr_t) */
+#define osThreadTimeSliceDefault      0xFFFFFFFFU ///< Round-robin timeout of the kernel configuration
+
 /* Mutex attributes */
 #define osMutexPrioInherit            (1UL<<0)    ///< Priority inherit protocol.
 #define osMutexRecursive              (1UL<<1)    ///< Recursive mutex.
 #define osMutexRobust                 (1UL<<2)    ///< Robust mutex.
+#define osMutexPrioCeiling            (1UL<<3)    ///< Immediate priority ceiling protocol.
 
 /* OS Configuration flags */
 #define osConfigPrivilegedMode        (1UL<<0)    ///< Threads in Privileged mode
 #define osConfigStackCheck            (1UL<<1)    ///< Stack overrun checking
 #define osConfigStackWatermark        (1UL<<2)    ///< Stack usage Watermark
+#define osConfigTicklessIdle          (1UL<<3)    ///< Tickless Idle mode
+#define osConfigCpuUsage              (1UL<<4)    ///< Thread CPU usage accounting
+
+/* Kernel error codes, see \ref osKernelErrorNotify */
+#define osKernelErrorStackOverflow    1U          ///< Stack overflow detected at thread switch
 
 /* Timeout value */
 #define osWaitForever                 (0xFFFFFFFF)
@@ -112,6 +121,14 @@ extern "C"
 #define time_after_eq(a,b)            ((int32_t)(a) - (int32_t)(b) >= 0)
 #define time_before_eq(a,b)           time_after_eq(b,a)
 
+/* Minimal thread stack size in bytes */
+#if (defined(__unix__) || defined(__APPLE__))
+/* POSIX host: thread context, signal frame and C library calls share the thread stack */
+#define osThreadStackSizeMin          16384U
+#else
+#define osThreadStackSizeMin          64U
+#endif
+
 /* Control Block sizes */
 #define osThreadCbSize                sizeof(osThread_t)
 #define osTimerCbSize                 sizeof(osTimer_t)
@@ -120,6 +137,10 @@ extern "C"
 #define osSemaphoreCbSize             sizeof(osSemaphore_t)
 #define osMemoryPoolCbSize            sizeof(osMemoryPool_t)
 #define osMessageQueueCbSize          sizeof(osMessageQueue_t)
+#define osRingBufferCbSize            sizeof(osRingBuffer_t)
+#define osStreamCbSize                sizeof(osStream_t)
+#define osHeapCbSize                  sizeof(osHeap_t)
+#define osMemorySlabCbSize            sizeof(osMemorySlab_t)
 
 /// Memory size in bytes for Memory Pool storage.
 /// \param         block_count   maximum number of memory blocks in memory pool.
@@ -127,14 +148,79 @@ extern "C"
 #define osMemoryPoolMemSize(block_count, block_size) \
   (4*(block_count)*(((block_size)+3)/4))
 
+/// Memory size in bytes for Memory Slab storage.
+/// \param         page_count    number of pages shared by the size classes.
+/// \param         page_size     page size in bytes, see \ref osMemorySlabNew.
+#define osMemorySlabMemSize(page_count, page_size) \
+  ((page_count)*((page_size)+sizeof(osMemorySlabPage_t))+8)
+
 /// Memory size in bytes for Message Queue storage.
 /// \param         msg_count     maximum number of messages in queue.
 /// \param         msg_size      maximum message size in bytes.
 #define osMessageQueueMemSize(msg_count, msg_size) \
   (4*(msg_count)*(3+(((msg_size)+3)/4)))
 
-/* Number priority levels */
+/* Number priority levels: 32, 64, 128 or 256. The kernel and the application
+   must be built with the same value. */
+#ifndef NUM_PRIORITY
 #define NUM_PRIORITY                  (32U)
+#endif
+#if ((NUM_PRIORITY != 32U) && (NUM_PRIORITY != 64U) && \
+     (NUM_PRIORITY != 128U) && (NUM_PRIORITY != 256U))
+#error "NUM_PRIORITY must be 32, 64, 128 or 256"
+#endif
+
+/* Priority of the threads that have used up their CPU budget. Thread and
+   mutex ceiling priorities above osPriorityIdle up to this level are rejected.
+   The default is the level below osPriorityLow. With 32 levels there is no
+   such level and osPriorityLow itself is reserved. */
+#ifndef BUDGET_PRIORITY
+#if (NUM_PRIORITY > 32U)
+#define BUDGET_PRIORITY               ((NUM_PRIORITY / 16U) - 1U)
+#else
+#define BUDGET_PRIORITY               (2U)
+#endif
+#endif
+#if ((BUDGET_PRIORITY < 2U) || (BUDGET_PRIORITY >= NUM_PRIORITY))
+#error "BUDGET_PRIORITY must be 2 to NUM_PRIORITY-1"
+#endif
+
+/* Message priorities with their own sub-list in a Message Queue: 1 to 32, 64,
+   128 or 256 (default). Each level takes a pointer in the control block. With
+   fewer levels, priorities from MSG_PRIO_LEVELS-1 up share the top sub-list,
+   which is kept sorted by a linear walk with interrupts disabled.
+   The kernel and the application must be built with the same value. */
+#ifndef MSG_PRIO_LEVELS
+#define MSG_PRIO_LEVELS               (256U)
+#endif
+#if (((MSG_PRIO_LEVELS < 1U) || (MSG_PRIO_LEVELS > 32U)) && (MSG_PRIO_LEVELS != 64U) && \
+     (MSG_PRIO_LEVELS != 128U) && (MSG_PRIO_LEVELS != 256U))
+#error "MSG_PRIO_LEVELS must be 1 to 32, 64, 128 or 256"
+#endif
+
+/* Heap blocks are kept in 16 sub-lists per power of two of their size. Blocks
+   up to 2^HEAP_SIZE_LOG2-1 bytes can be handled, 8 to 31. The kernel and the
+   application must be built with the same value. */
+#ifndef HEAP_SIZE_LOG2
+#define HEAP_SIZE_LOG2                (20U)
+#endif
+#if ((HEAP_SIZE_LOG2 < 8U) || (HEAP_SIZE_LOG2 > 31U))
+#error "HEAP_SIZE_LOG2 must be 8 to 31"
+#endif
+#define HEAP_SL_LOG2                  (4U)
+#define HEAP_SL_COUNT                 (1U << HEAP_SL_LOG2)
+#define HEAP_FL_COUNT                 (HEAP_SIZE_LOG2 - 6U)
+
+/* Maximum number of power of two size classes of a Memory Slab, 1 to 16 */
+#ifndef MEM_SLAB_CLASSES
+#define MEM_SLAB_CLASSES              (8U)
+#endif
+#if ((MEM_SLAB_CLASSES < 1U) || (MEM_SLAB_CLASSES > 16U))
+#error "MEM_SLAB_CLASSES must be 1 to 16"
+#endif
+
+/* Priority levels per step of the CMSIS priority scale */
+#define osPriorityStep                ((int32_t)NUM_PRIORITY / 32)
 
 /*******************************************************************************
  *  typedefs and structures
@@ -170,42 +256,44 @@ typedef enum {
 } osStatus_t;
 
 /// Priority values.
+/// With NUM_PRIORITY above 32 each step of the scale spans osPriorityStep levels
+/// and any value above BUDGET_PRIORITY up to osPriorityISR is a valid priority.
 typedef enum {
-  osPriorityNone          =  0,         ///< No priority (not initialized).
-  osPriorityIdle          =  1,         ///< Reserved for Idle thread.
-  osPriorityLow           =  2,         ///< Priority: low
-  osPriorityLow1          =  2+1,       ///< Priority: low + 1
-  osPriorityLow2          =  2+2,       ///< Priority: low + 2
-  osPriorityLow3          =  2+3,       ///< Priority: low + 3
-  osPriorityLow4          =  2+4,       ///< Priority: low + 4
-  osPriorityBelowNormal   =  7,         ///< Priority: below normal
-  osPriorityBelowNormal1  =  7+1,       ///< Priority: below normal + 1
-  osPriorityBelowNormal2  =  7+2,       ///< Priority: below normal + 2
-  osPriorityBelowNormal3  =  7+3,       ///< Priority: below normal + 3
-  osPriorityBelowNormal4  =  7+4,       ///< Priority: below normal + 4
-  osPriorityNormal        = 12,         ///< Priority: normal
-  osPriorityNormal1       = 12+1,       ///< Priority: normal + 1
-  osPriorityNormal2       = 12+2,       ///< Priority: normal + 2
-  osPriorityNormal3       = 12+3,       ///< Priority: normal + 3
-  osPriorityNormal4       = 12+4,       ///< Priority: normal + 4
-  osPriorityAboveNormal   = 17,         ///< Priority: above normal
-  osPriorityAboveNormal1  = 17+1,       ///< Priority: above normal + 1
-  osPriorityAboveNormal2  = 17+2,       ///< Priority: above normal + 2
-  osPriorityAboveNormal3  = 17+3,       ///< Priority: above normal + 3
-  osPriorityAboveNormal4  = 17+4,       ///< Priority: above normal + 4
-  osPriorityHigh          = 22,         ///< Priority: high
-  osPriorityHigh1         = 22+1,       ///< Priority: high + 1
-  osPriorityHigh2         = 22+2,       ///< Priority: high + 2
-  osPriorityHigh3         = 22+3,       ///< Priority: high + 3
-  osPriorityHigh4         = 22+4,       ///< Priority: high + 4
-  osPriorityRealtime      = 27,         ///< Priority: realtime
-  osPriorityRealtime1     = 27+1,       ///< Priority: realtime + 1
-  osPriorityRealtime2     = 27+2,       ///< Priority: realtime + 2
-  osPriorityRealtime3     = 27+3,       ///< Priority: realtime + 3
-  osPriorityRealtime4     = 27+4,       ///< Priority: realtime + 4
-  osPriorityISR           = 32,         ///< Reserved for ISR deferred thread.
-  osPriorityError         = -1,         ///< System cannot determine priority or illegal priority.
-  osPriorityReserved      = 0x7FFFFFFF  ///< Prevents enum down-size compiler optimization.
+  osPriorityNone          =  0,                   ///< No priority (not initialized).
+  osPriorityIdle          =  1,                   ///< Reserved for Idle thread.
+  osPriorityLow           = 2*osPriorityStep,     ///< Priority: low
+  osPriorityLow1          = 2*osPriorityStep+1,   ///< Priority: low + 1
+  osPriorityLow2          = 2*osPriorityStep+2,   ///< Priority: low + 2
+  osPriorityLow3          = 2*osPriorityStep+3,   ///< Priority: low + 3
+  osPriorityLow4          = 2*osPriorityStep+4,   ///< Priority: low + 4
+  osPriorityBelowNormal   = 7*osPriorityStep,     ///< Priority: below normal
+  osPriorityBelowNormal1  = 7*osPriorityStep+1,   ///< Priority: below normal + 1
+  osPriorityBelowNormal2  = 7*osPriorityStep+2,   ///< Priority: below normal + 2
+  osPriorityBelowNormal3  = 7*osPriorityStep+3,   ///< Priority: below normal + 3
+  osPriorityBelowNormal4  = 7*osPriorityStep+4,   ///< Priority: below normal + 4
+  osPriorityNormal        = 12*osPriorityStep,    ///< Priority: normal
+  osPriorityNormal1       = 12*osPriorityStep+1,  ///< Priority: normal + 1
+  osPriorityNormal2       = 12*osPriorityStep+2,  ///< Priority: normal + 2
+  osPriorityNormal3       = 12*osPriorityStep+3,  ///< Priority: normal + 3
+  osPriorityNormal4       = 12*osPriorityStep+4,  ///< Priority: normal + 4
+  osPriorityAboveNormal   = 17*osPriorityStep,    ///< Priority: above normal
+  osPriorityAboveNormal1  = 17*osPriorityStep+1,  ///< Priority: above normal + 1
+  osPriorityAboveNormal2  = 17*osPriorityStep+2,  ///< Priority: above normal + 2
+  osPriorityAboveNormal3  = 17*osPriorityStep+3,  ///< Priority: above normal + 3
+  osPriorityAboveNormal4  = 17*osPriorityStep+4,  ///< Priority: above normal + 4
+  osPriorityHigh          = 22*osPriorityStep,    ///< Priority: high
+  osPriorityHigh1         = 22*osPriorityStep+1,  ///< Priority: high + 1
+  osPriorityHigh2         = 22*osPriorityStep+2,  ///< Priority: high + 2
+  osPriorityHigh3         = 22*osPriorityStep+3,  ///< Priority: high + 3
+  osPriorityHigh4         = 22*osPriorityStep+4,  ///< Priority: high + 4
+  osPriorityRealtime      = 27*osPriorityStep,    ///< Priority: realtime
+  osPriorityRealtime1     = 27*osPriorityStep+1,  ///< Priority: realtime + 1
+  osPriorityRealtime2     = 27*osPriorityStep+2,  ///< Priority: realtime + 2
+  osPriorityRealtime3     = 27*osPriorityStep+3,  ///< Priority: realtime + 3
+  osPriorityRealtime4     = 27*osPriorityStep+4,  ///< Priority: realtime + 4
+  osPriorityISR           = 32*osPriorityStep,    ///< Reserved for ISR deferred thread.
+  osPriorityError         = -1,                   ///< System cannot determine priority or illegal priority.
+  osPriorityReserved      = 0x7FFFFFFF            ///< Prevents enum down-size compiler optimization.
 } osPriority_t;
 
 /// Thread state.
@@ -250,13 +338,24 @@ typedef struct winfo_msgque {
 
 typedef struct winfo_dataque {
   uint32_t  data_ptr;
+  uint32_t  count;      ///< Number of data for PutN/GetN, 0 for Put/Get
 } winfo_dataque_t;
 
+typedef struct winfo_stream {
+  uint32_t  data_ptr;   ///< Data not yet moved
+  uint32_t  size;       ///< Number of bytes not yet moved
+  uint32_t  done;       ///< Number of bytes already written
+} winfo_stream_t;
+
 typedef struct winfo_flags {
   uint32_t flags;
   uint32_t options;
 } winfo_flags_t;
 
+typedef struct winfo_mutex {
+  struct osMutex_s *mutex;
+} winfo_mutex_t;
+
 /*
  * Definition of wait information in thread control block
  */
@@ -264,8 +363,10 @@ typedef struct winfo_s {
   union {
     winfo_msgque_t  msgque;
     winfo_dataque_t dataque;
+    winfo_stream_t  stream;
     winfo_flags_t   event;
     winfo_flags_t   thread;
+    winfo_mutex_t   mutex;
   };
   uint32_t ret_val;
 } winfo_t;
@@ -291,6 +392,18 @@ typedef void *osMessageQueueId_t;
 /// \details Data Queue ID identifies the data queue.
 typedef void *osDataQueueId_t;
 
+/// \details Ring Buffer ID identifies the ring buffer.
+typedef void *osRingBufferId_t;
+
+/// \details Stream ID identifies the stream buffer.
+typedef void *osStreamId_t;
+
+/// \details Heap ID identifies the heap.
+typedef void *osHeapId_t;
+
+/// \details Memory Slab ID identifies the memory slab.
+typedef void *osMemorySlabId_t;
+
 /// \details Memory Pool ID identifies the memory pool.
 typedef void *osMemoryPoolId_t;
 
@@ -301,13 +414,12 @@ typedef struct osThread_s {
   queue_t                  thread_que;  ///< Queue is used to include thread in ready/wait lists
   queue_t                   mutex_que;  ///< List of all mutexes that tack locked
   queue_t                   delay_que;  ///< Queue is used to include thread id delay list
-  uint32_t                      delay;  ///< Delay Time
   void                       *stk_mem;  ///< Base address of thread's stack space
+  uint32_t                      delay;  ///< Delay Time
   uint32_t                   stk_size;  ///< Task's stack size (in bytes)
-  uint32_t                 time_slice;  ///< Task time slice
-  int8_t                base_priority;  ///< Task base priority
-  int8_t                     priority;  ///< Task current priority
-  uint16_t                   reserved;
+  uint32_t                slice_count;  ///< Ticks run in the current round-robin time slice
+  int16_t               base_priority;  ///< Task base priority
+  int16_t                    priority;  ///< Task current priority
   uint8_t                          id;  ///< ID for verification(is it a thread or another object?)
   uint8_t                       state;  ///< Task state
   uint8_t                       flags;  ///< Object Flags
@@ -316,6 +428,20 @@ typedef struct osThread_s {
   winfo_t                       winfo;  ///< Wait information
   uint32_t               thread_flags;  ///< Thread Flags
   const char                    *name;  ///< Object Name
+  queue_t                    list_que;  ///< Queue is used to include thread in the list of all threads
+  uint64_t                   cpu_time;  ///< CPU time [system timer counts]
+  uint32_t                 cpu_window;  ///< CPU time in the current usage window
+  uint32_t                   cpu_prev;  ///< CPU time in the previous usage window
+  uint32_t             cpu_window_idx;  ///< Index of the current usage window [seconds]
+  uint32_t                   deadline;  ///< Absolute deadline of the current job [ticks]
+  uint32_t               rel_deadline;  ///< Relative deadline [ticks], 0 - not an EDF thread
+  uint32_t                     period;  ///< Period [ticks]
+  queue_t                  budget_que;  ///< Entry in the list of threads with an exhausted budget
+  uint32_t                     budget;  ///< CPU budget per period [system timer counts], 0 - no budget
+  int32_t                 budget_left;  ///< Remaining CPU budget [system timer counts]
+  uint32_t              budget_period;  ///< Budget replenishment period [ticks]
+  uint32_t             budget_release;  ///< Tick of the next replenishment
+  uint32_t                    quantum;  ///< Round-robin time slice [ticks], 0 - run until blocked
 } osThread_t;
 
 /* Semaphore Control Block */
@@ -367,6 +493,101 @@ typedef struct osMemoryPool_s {
   const char                    *name;  ///< Object Name
 } osMemoryPool_t;
 
+/* Memory Slab Page */
+typedef struct osMemorySlabPage_s {
+  queue_t                    page_que;  ///< Entry in the list of free or partially used Pages
+  osMemoryPoolInfo_t             info;  ///< Blocks of the Page
+  uint32_t                 size_class;  ///< Size class of the Page
+} osMemorySlabPage_t;
+
+/* Memory Slab size class */
+typedef struct osMemorySlabClass_s {
+  queue_t                     partial;  ///< Pages with free Blocks
+  uint32_t                 page_count;  ///< Number of Pages of the class
+  uint32_t                used_blocks;  ///< Number of used Blocks
+  uint32_t            max_used_blocks;  ///< Highest number of used Blocks
+} osMemorySlabClass_t;
+
+/* Memory Slab Control Block */
+typedef struct osMemorySlab_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t              reserved_state;  ///< Object State (not used)
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  queue_t                  post_queue;  ///< Post Processing queue
+  queue_t                   free_page;  ///< Pages not used by any class
+  osMemorySlabPage_t            *page;  ///< Page descriptors
+  uint8_t                   *page_mem;  ///< Page Memory Base Address
+  uint32_t                 page_count;  ///< Number of Pages
+  uint32_t                  page_free;  ///< Number of free Pages
+  uint8_t                   page_log2;  ///< Log2 of the Page size
+  uint8_t                    min_log2;  ///< Log2 of the smallest Block size
+  uint8_t                 class_count;  ///< Number of size classes
+  uint8_t                   reserved2;
+  const char                    *name;  ///< Object Name
+  osMemorySlabClass_t classes[MEM_SLAB_CLASSES]; ///< Size classes
+} osMemorySlab_t;
+
+/* Memory Slab statistics */
+typedef struct osMemorySlabStats_s {
+  uint32_t                  page_size;  ///< Page size in bytes
+  uint32_t                 page_count;  ///< Number of Pages
+  uint32_t                  page_free;  ///< Number of Pages not used by any class
+  uint32_t                  used_size;  ///< Bytes in used Blocks
+  uint32_t                 waste_size;  ///< Bytes in free Blocks of Pages held by a class
+  uint32_t                       fill;  ///< Used bytes of the Pages held by classes, in percent
+  uint32_t                class_count;  ///< Number of size classes
+  struct {
+    uint32_t               block_size;  ///< Block size in bytes
+    uint32_t               page_count;  ///< Number of Pages of the class
+    uint32_t              used_blocks;  ///< Number of used Blocks
+    uint32_t          max_used_blocks;  ///< Highest number of used Blocks
+  } classes[MEM_SLAB_CLASSES];
+} osMemorySlabStats_t;
+
+/* - Heap definitions   -------------------------------------------------------*/
+
+/* Heap Block header */
+typedef struct osHeapBlock_s {
+  struct osHeapBlock_s     *prev_phys;  ///< Physically previous Block
+  uint32_t                       size;  ///< Payload size in bytes and Block flags
+  struct osHeapBlock_s     *next_free;  ///< Next free Block of the same size class (free Block only)
+  struct osHeapBlock_s     *prev_free;  ///< Previous free Block of the same size class (free Block only)
+} osHeapBlock_t;
+
+/* Heap Control Block */
+typedef struct osHeap_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t              reserved_state;  ///< Object State (not used)
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  queue_t                  post_queue;  ///< Post Processing queue
+  void                      *isr_free;  ///< Blocks freed by ISRs, waiting for post ISR processing
+  uint8_t                   *heap_mem;  ///< Heap Memory Address
+  uint32_t                  heap_size;  ///< Heap Memory size in bytes
+  uint32_t                  used_size;  ///< Bytes in allocated Blocks
+  uint32_t              max_used_size;  ///< Highest value of used_size
+  uint32_t                used_blocks;  ///< Number of allocated Blocks
+  uint32_t                  free_size;  ///< Bytes in free Blocks
+  uint32_t                free_blocks;  ///< Number of free Blocks
+  const char                    *name;  ///< Object Name
+  uint32_t                     fl_bmp;  ///< Non-empty first level classes
+  uint32_t      sl_bmp[HEAP_FL_COUNT];  ///< Non-empty second level classes
+  osHeapBlock_t *free_list[HEAP_FL_COUNT][HEAP_SL_COUNT]; ///< Free Blocks of each size class
+} osHeap_t;
+
+/* Heap statistics */
+typedef struct osHeapStats_s {
+  uint32_t                 total_size;  ///< Heap Memory size in bytes
+  uint32_t                  used_size;  ///< Bytes in allocated Blocks
+  uint32_t              max_used_size;  ///< Highest number of bytes ever allocated
+  uint32_t                used_blocks;  ///< Number of allocated Blocks
+  uint32_t                  free_size;  ///< Bytes in free Blocks
+  uint32_t                free_blocks;  ///< Number of free Blocks
+  uint32_t             max_free_block;  ///< Size of the largest free Block
+  uint32_t              fragmentation;  ///< Free bytes outside the largest free Block, in percent
+} osHeapStats_t;
+
 /* - Message Queue definitions   -----------------------------------------------*/
 
 /* Message Control Block */
@@ -392,6 +613,13 @@ typedef struct osMessageQueue_s {
   uint32_t                  msg_count;  ///< Number of queued Messages
   queue_t                   msg_queue;  ///< List of all queued Messages
   const char                    *name;  ///< Object Name
+  struct {
+#if (MSG_PRIO_LEVELS > 32U)
+    uint32_t                    group;  ///< Non-empty bitmap words
+#endif
+    uint32_t map[(MSG_PRIO_LEVELS + 31U) / 32U]; ///< Non-empty priority levels
+  } msg_bmp;
+  osMessage_t *msg_tail[MSG_PRIO_LEVELS];   ///< Last queued Message of each priority level
 } osMessageQueue_t;
 
 /* Data Queue Control Block */
@@ -407,12 +635,56 @@ typedef struct osDataQueue_s {
   uint32_t                  data_size;  ///< Data size in bytes
   uint32_t                 data_count;  ///< Number of queued Data
   uint32_t                 data_limit;  ///< Data Limit
-  uint32_t                       head;
-  uint32_t                       tail;
+  uint32_t                       head;  ///< Write offset, reserved slots included
+  uint32_t                       tail;  ///< Read offset
+  uint32_t                put_pending;  ///< Data reserved by senders, not yet published
+  uint32_t                get_pending;  ///< Data taken by receivers, not yet freed
+  uint16_t                   put_nest;  ///< Number of senders copying data
+  uint16_t                   get_nest;  ///< Number of receivers copying data
   uint8_t                     *dq_mem;  ///< Data Memory Address
   const char                    *name;  ///< Object Name
 } osDataQueue_t;
 
+/* Ring Buffer Control Block */
+typedef struct osRingBuffer_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t              reserved_state;  ///< Object State (not used)
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  queue_t                  post_queue;  ///< Post Processing queue
+  queue_t                  wait_queue;  ///< Consumer waiting for the trigger level
+  uint32_t                 data_count;  ///< Number of Data (power of 2)
+  uint32_t                  data_size;  ///< Data size in bytes
+  uint32_t                    trigger;  ///< Consumer wakeup level
+  volatile uint32_t              head;  ///< Write index, written by the producer only
+  volatile uint32_t              tail;  ///< Read index, written by the consumer only
+  volatile uint32_t        wait_level;  ///< Level the waiting consumer needs or 0
+  uint8_t                     *rb_mem;  ///< Data Memory Address
+  const char                    *name;  ///< Object Name
+} osRingBuffer_t;
+
+/* Stream Buffer Control Block */
+typedef struct osStream_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t              reserved_state;  ///< Object State (not used)
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  queue_t                  post_queue;  ///< Post Processing queue
+  queue_t            wait_write_queue;  ///< Queue of threads waiting to write
+  queue_t             wait_read_queue;  ///< Queue of threads waiting to read
+  uint32_t                       size;  ///< Buffer size in bytes
+  uint32_t                      count;  ///< Number of bytes in the buffer
+  uint32_t                    trigger;  ///< Reader wakeup level in bytes
+  uint32_t                       head;  ///< Write index, reserved space included
+  uint32_t                       tail;  ///< Read index
+  uint32_t                put_pending;  ///< Bytes reserved by writers, not yet published
+  uint32_t                get_pending;  ///< Bytes taken by readers, not yet freed
+  uint16_t                   put_nest;  ///< Number of writers copying data
+  uint16_t                   get_nest;  ///< Number of readers copying data
+  uint8_t                     *sb_mem;  ///< Buffer Memory Address
+  const char                    *name;  ///< Object Name
+} osStream_t;
+
 /* Mutex Control Block */
 typedef struct osMutex_s {
   uint8_t                          id;  ///< Object Identifier
@@ -425,6 +697,8 @@ typedef struct osMutex_s {
   osThread_t                  *holder;  ///< Current mutex owner(thread that locked mutex)
   uint32_t                        cnt;  ///< Lock counter
   const char                    *name;  ///< Object Name
+  uint32_t                       lock;  ///< Owner word of the thread mode fast path
+  int16_t                     ceiling;  ///< Priority ceiling
 } osMutex_t;
 
 /* Timer Control Block */
@@ -455,6 +729,10 @@ typedef struct {
   void                    *stack_mem;   ///< memory for stack
   uint32_t                stack_size;   ///< size of stack
   osPriority_t              priority;   ///< initial thread priority (default: osPriorityNormal)
+  uint32_t                  deadline;   ///< relative deadline in ticks (default: 0 - not an EDF thread)
+  uint32_t                    period;   ///< period in ticks (default: deadline)
+  uint32_t                time_slice;   ///< round-robin time slice in ticks, 0 - run until blocked
+                                        ///< (default: \ref osThreadTimeSliceDefault)
 } osThreadAttr_t;
 
 /// Attributes structure for timer.
@@ -487,6 +765,7 @@ typedef struct {
   uint32_t                 attr_bits;   ///< attribute bits
   void                       *cb_mem;   ///< memory for control block
   uint32_t                   cb_size;   ///< size of provided memory for control block
+  osPriority_t               ceiling;   ///< priority ceiling (osMutexPrioCeiling only)
 } osMutexAttr_t;
 
 /// Attributes structure for message queue.
@@ -509,6 +788,28 @@ typedef struct osDataQueueAttr_s {
   uint32_t                   dq_size;   ///< size of provided memory for data storage
 } osDataQueueAttr_t;
 
+/// Attributes structure for ring buffer.
+typedef struct osRingBufferAttr_s {
+  const char                   *name;   ///< name of the ring buffer
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                       *cb_mem;   ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+  void                       *rb_mem;   ///< memory for data storage
+  uint32_t                   rb_size;   ///< size of provided memory for data storage
+  uint32_t                   trigger;   ///< number of data that wakes the consumer (0 = 1)
+} osRingBufferAttr_t;
+
+/// Attributes structure for stream buffer.
+typedef struct osStreamAttr_s {
+  const char                   *name;   ///< name of the stream buffer
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                       *cb_mem;   ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+  void                       *sb_mem;   ///< memory for data storage
+  uint32_t                   sb_size;   ///< size of provided memory for data storage
+  uint32_t                   trigger;   ///< number of bytes that wakes a reader (0 = 1)
+} osStreamAttr_t;
+
 /// Attributes structure for memory pool.
 typedef struct {
   const char                   *name;   ///< name of the memory pool
@@ -519,6 +820,26 @@ typedef struct {
   uint32_t                   mp_size;   ///< size of provided memory for data storage
 } osMemoryPoolAttr_t;
 
+/// Attributes structure for memory slab.
+typedef struct {
+  const char                   *name;   ///< name of the memory slab
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                       *cb_mem;   ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+  void                       *ms_mem;   ///< memory for pages and page descriptors
+  uint32_t                   ms_size;   ///< size of provided memory
+} osMemorySlabAttr_t;
+
+/// Attributes structure for heap.
+typedef struct {
+  const char                   *name;   ///< name of the heap
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                       *cb_mem;   ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+  void                     *heap_mem;   ///< memory for heap storage
+  uint32_t                 heap_size;   ///< size of provided memory for heap storage
+} osHeapAttr_t;
+
 /* OS Configuration structure */
 typedef struct osConfig_s {
   uint32_t                             flags;   ///< OS Configuration Flags
@@ -528,6 +849,22 @@ typedef struct osConfig_s {
   osThreadAttr_t           *idle_thread_attr;   ///< Idle Thread Attributes
   const
   osThreadAttr_t          *timer_thread_attr;   ///< Timer Thread Attributes
+  uint32_t                 thread_stack_size;   ///< Default Thread Stack size
+  struct {                                      ///< Object specific Memory Pools
+    osMemoryPoolInfo_t                *stack;   ///< Default Thread Stack
+    osMemoryPoolInfo_t               *thread;   ///< Thread Control Blocks
+    osMemoryPoolInfo_t                *timer;   ///< Timer Control Blocks
+    osMemoryPoolInfo_t          *event_flags;   ///< Event Flags Control Blocks
+    osMemoryPoolInfo_t                *mutex;   ///< Mutex Control Blocks
+    osMemoryPoolInfo_t            *semaphore;   ///< Semaphore Control Blocks
+    osMemoryPoolInfo_t          *memory_pool;   ///< Memory Pool Control Blocks
+    osMemoryPoolInfo_t        *message_queue;   ///< Message Queue Control Blocks
+  } mpi;
+  struct {                                      ///< Global Dynamic Memory
+    osHeap_t                             *cb;   ///< Heap Control Block
+    void                                *mem;   ///< Heap storage
+    uint32_t                            size;   ///< Heap storage size
+  } heap;
 } osConfig_t;
 
 /*******************************************************************************
@@ -542,6 +879,8 @@ extern const osConfig_t osConfig;       ///< Kernel Configuration
 
 /* OS Idle Thread */
 extern void osIdleThread(void *argument);
+/* OS Error Callback, called in handler mode with the object that caused the error */
+extern uint32_t osKernelErrorNotify(uint32_t code, void *object_id);
 /* OS Exception handlers */
 extern void SVC_Handler(void);
 extern void PendSV_Handler(void);
@@ -604,6 +943,20 @@ int32_t osKernelUnlock(void);
  */
 int32_t osKernelRestoreLock(int32_t lock);
 
+/**
+ * @fn          uint32_t osKernelSuspend(void)
+ * @brief       Suspend the RTOS Kernel scheduler.
+ * @return      time in ticks, for how long the system can sleep or power-down.
+ */
+uint32_t osKernelSuspend(void);
+
+/**
+ * @fn          void osKernelResume(uint32_t sleep_ticks)
+ * @brief       Resume the RTOS Kernel scheduler.
+ * @param[in]   sleep_ticks   time in ticks for how long the system was in sleep or power-down mode.
+ */
+void osKernelResume(uint32_t sleep_ticks);
+
 /**
  * @fn          uint32_t osKernelGetTickCount(void)
  * @brief       Get the RTOS kernel tick count.
@@ -632,6 +985,14 @@ uint32_t osKernelGetSysTimerCount(void);
  */
 uint32_t osKernelGetSysTimerFreq(void);
 
+/**
+ * @fn          uint32_t osKernelGetCpuLoad(void)
+ * @brief       Get the CPU load over the last second, estimated from the
+ *              current and the previous one-second window.
+ * @return      CPU load in percent (time not spent in the Idle Thread).
+ */
+uint32_t osKernelGetCpuLoad(void);
+
 /**
  * @brief       Convert a microseconds value to a RTOS kernel system timer value.
  * @param       microsec  time value in microseconds.
@@ -748,6 +1109,23 @@ uint32_t osThreadGetStackSize(osThreadId_t thread_id);
  */
 uint32_t osThreadGetStackSpace(osThreadId_t thread_id);
 
+/**
+ * @fn          uint64_t osThreadGetCpuTime(osThreadId_t thread_id)
+ * @brief       Get CPU time consumed by a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      CPU time in system timer counts or 0 in case of an error.
+ */
+uint64_t osThreadGetCpuTime(osThreadId_t thread_id);
+
+/**
+ * @fn          uint32_t osThreadGetCpuUsage(osThreadId_t thread_id)
+ * @brief       Get CPU usage of a thread over the last second, estimated from
+ *              the current and the previous one-second window.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      CPU usage in percent or 0 in case of an error.
+ */
+uint32_t osThreadGetCpuUsage(osThreadId_t thread_id);
+
 /**
  * @fn          osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
  * @brief       Change priority of a thread.
@@ -772,6 +1150,49 @@ osPriority_t osThreadGetPriority(osThreadId_t thread_id);
  */
 osStatus_t osThreadYield(void);
 
+/**
+ * @fn          osStatus_t osThreadSetTimeSlice(osThreadId_t thread_id, uint32_t time_slice)
+ * @brief       Change the round-robin time slice of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   time_slice  time slice in ticks, 0 - run until blocked,
+ *                          \ref osThreadTimeSliceDefault - robin timeout of the kernel configuration.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadSetTimeSlice(osThreadId_t thread_id, uint32_t time_slice);
+
+/**
+ * @fn          osStatus_t osThreadSetDeadline(osThreadId_t thread_id, uint32_t deadline, uint32_t period)
+ * @brief       Change the deadline and the period of a thread and start a new job.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   deadline    relative deadline in ticks, 0 - schedule by priority only.
+ * @param[in]   period      period in ticks, 0 - equal to the deadline.
+ * @return      status code that indicates the execution status of the function.
+ * @note        Threads with a deadline are scheduled earliest deadline first
+ *              among the ready threads of the same priority.
+ */
+osStatus_t osThreadSetDeadline(osThreadId_t thread_id, uint32_t deadline, uint32_t period);
+
+/**
+ * @fn          osStatus_t osThreadSetBudget(osThreadId_t thread_id, uint32_t budget, uint32_t period)
+ * @brief       Limit the CPU time of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   budget      CPU time per period in microseconds, 0 - no limit.
+ * @param[in]   period      replenishment period in ticks.
+ * @return      status code that indicates the execution status of the function.
+ * @note        A thread that has used up its budget runs at BUDGET_PRIORITY
+ *              until the budget is replenished.
+ */
+osStatus_t osThreadSetBudget(osThreadId_t thread_id, uint32_t budget, uint32_t period);
+
+/**
+ * @fn          osStatus_t osThreadWaitPeriod(void)
+ * @brief       Finish the current job of the running thread and wait for the
+ *              start of the next period.
+ * @return      status code that indicates the execution status of the function.
+ *              osErrorTimeout - the next period has already started.
+ */
+osStatus_t osThreadWaitPeriod(void);
+
 /**
  * @fn          osStatus_t osThreadSuspend(osThreadId_t thread_id)
  * @brief       Suspend execution of a thread.
@@ -976,6 +1397,45 @@ osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint
  */
 osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
 
+/**
+ * @fn          void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+ * @brief       Allocate a Message block from a Queue to fill in place or timeout if Queue is full.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the message payload or NULL in case of error.
+ */
+void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+ * @brief       Put a Message block obtained by \ref osMessageQueueAlloc into a Queue without copying.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   message payload obtained by \ref osMessageQueueAlloc.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio);
+
+/**
+ * @fn          void *osMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+ * @brief       Get a Message from a Queue without copying or timeout if Queue is empty.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[out]  msg_prio  pointer to buffer for message priority or NULL.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the message payload or NULL in case of error.
+ */
+void *osMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+ * @brief       Return a Message block obtained by \ref osMessageQueueReceiveRef or
+ *              \ref osMessageQueueAlloc back to a Queue.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   message payload owned by the caller.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr);
+
 /**
  * @fn          uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
  * @brief       Get maximum number of messages in a Message Queue.
@@ -1066,6 +1526,28 @@ osStatus_t osDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint32_t
  */
 osStatus_t osDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeout);
 
+/**
+ * @fn          uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Put up to count Data into a Queue or timeout if Queue is full.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[in]   data_ptr  pointer to buffer with data to put into a queue.
+ * @param[in]   count     number of data in the buffer.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data put into a queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Get up to count Data from a Queue or timeout if Queue is empty.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[out]  data_ptr  pointer to buffer for data to get from a queue.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data got from a queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout);
+
 /**
  * @fn          uint32_t osDataQueueGetCapacity(osDataQueueId_t dq_id)
  * @brief       Get maximum number of data in a Data Queue.
@@ -1114,6 +1596,150 @@ osStatus_t osDataQueueReset(osDataQueueId_t dq_id);
  */
 osStatus_t osDataQueueDelete(osDataQueueId_t dq_id);
 
+/*******************************************************************************
+ *  Ring Buffer
+ ******************************************************************************/
+
+/**
+ * @fn          osRingBufferId_t osRingBufferNew(uint32_t data_count, uint32_t data_size, const osRingBufferAttr_t *attr)
+ * @brief       Create and Initialize a single producer, single consumer Ring Buffer object.
+ * @param[in]   data_count  maximum number of data in the buffer (power of 2).
+ * @param[in]   data_size   data size in bytes.
+ * @param[in]   attr        ring buffer attributes.
+ * @return      ring buffer ID for reference by other functions or NULL in case of error.
+ */
+osRingBufferId_t osRingBufferNew(uint32_t data_count, uint32_t data_size, const osRingBufferAttr_t *attr);
+
+/**
+ * @fn          const char *osRingBufferGetName(osRingBufferId_t rb_id)
+ * @brief       Get name of a Ring Buffer object.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osRingBufferGetName(osRingBufferId_t rb_id);
+
+/**
+ * @fn          uint32_t osRingBufferWrite(osRingBufferId_t rb_id, const void *data_ptr, uint32_t count)
+ * @brief       Write up to count Data into a Ring Buffer. Must be called by the producer only.
+ * @param[in]   rb_id     ring buffer ID obtained by \ref osRingBufferNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data written.
+ */
+uint32_t osRingBufferWrite(osRingBufferId_t rb_id, const void *data_ptr, uint32_t count);
+
+/**
+ * @fn          uint32_t osRingBufferRead(osRingBufferId_t rb_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Read up to count Data from a Ring Buffer, wait for the trigger level
+ *              or timeout if less data is available. Must be called by the consumer only.
+ * @param[in]   rb_id     ring buffer ID obtained by \ref osRingBufferNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data read.
+ */
+uint32_t osRingBufferRead(osRingBufferId_t rb_id, void *data_ptr, uint32_t count, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osRingBufferGetCount(osRingBufferId_t rb_id)
+ * @brief       Get number of Data in a Ring Buffer.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      number of data or 0 in case of an error.
+ */
+uint32_t osRingBufferGetCount(osRingBufferId_t rb_id);
+
+/**
+ * @fn          uint32_t osRingBufferGetSpace(osRingBufferId_t rb_id)
+ * @brief       Get number of free slots for Data in a Ring Buffer.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      number of free slots or 0 in case of an error.
+ */
+uint32_t osRingBufferGetSpace(osRingBufferId_t rb_id);
+
+/**
+ * @fn          osStatus_t osRingBufferDelete(osRingBufferId_t rb_id)
+ * @brief       Delete a Ring Buffer object.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osRingBufferDelete(osRingBufferId_t rb_id);
+
+/*******************************************************************************
+ *  Stream Buffer
+ ******************************************************************************/
+
+/**
+ * @fn          osStreamId_t osStreamNew(uint32_t size, const osStreamAttr_t *attr)
+ * @brief       Create and Initialize a Stream Buffer object.
+ * @param[in]   size    buffer size in bytes.
+ * @param[in]   attr    stream buffer attributes.
+ * @return      stream buffer ID for reference by other functions or NULL in case of error.
+ */
+osStreamId_t osStreamNew(uint32_t size, const osStreamAttr_t *attr);
+
+/**
+ * @fn          const char *osStreamGetName(osStreamId_t sb_id)
+ * @brief       Get name of a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osStreamGetName(osStreamId_t sb_id);
+
+/**
+ * @fn          uint32_t osStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Write bytes into a Stream Buffer, wait until all bytes are written or timeout.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   size      number of bytes to write.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes written.
+ */
+uint32_t osStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Read up to size bytes from a Stream Buffer, wait for the trigger level
+ *              or timeout if less data is available.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   size      number of bytes the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes read.
+ */
+uint32_t osStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osStreamGetCount(osStreamId_t sb_id)
+ * @brief       Get number of bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      number of bytes or 0 in case of an error.
+ */
+uint32_t osStreamGetCount(osStreamId_t sb_id);
+
+/**
+ * @fn          uint32_t osStreamGetSpace(osStreamId_t sb_id)
+ * @brief       Get number of free bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      number of free bytes or 0 in case of an error.
+ */
+uint32_t osStreamGetSpace(osStreamId_t sb_id);
+
+/**
+ * @fn          osStatus_t osStreamReset(osStreamId_t sb_id)
+ * @brief       Reset a Stream Buffer to initial empty state.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamReset(osStreamId_t sb_id);
+
+/**
+ * @fn          osStatus_t osStreamDelete(osStreamId_t sb_id)
+ * @brief       Delete a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamDelete(osStreamId_t sb_id);
+
 /*******************************************************************************
  *  Event Flags
  ******************************************************************************/
@@ -1260,6 +1886,121 @@ uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id);
  */
 osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id);
 
+/*******************************************************************************
+ *  Memory Slab
+ ******************************************************************************/
+
+/**
+ * @fn          osMemorySlabId_t osMemorySlabNew(uint32_t min_size, uint32_t max_size, const osMemorySlabAttr_t *attr)
+ * @brief       Create and Initialize a Memory Slab object. Blocks of all power of two sizes
+ *              from min_size to max_size are taken from Pages of one memory region. The Page
+ *              size is max_size but at least 32 blocks of min_size.
+ * @param[in]   min_size  smallest memory block size in bytes.
+ * @param[in]   max_size  largest memory block size in bytes.
+ * @param[in]   attr      memory slab attributes.
+ * @return      memory slab ID for reference by other functions or NULL in case of error.
+ */
+osMemorySlabId_t osMemorySlabNew(uint32_t min_size, uint32_t max_size, const osMemorySlabAttr_t *attr);
+
+/**
+ * @fn          const char *osMemorySlabGetName(osMemorySlabId_t ms_id)
+ * @brief       Get name of a Memory Slab object.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osMemorySlabGetName(osMemorySlabId_t ms_id);
+
+/**
+ * @fn          void *osMemorySlabAlloc(osMemorySlabId_t ms_id, uint32_t size)
+ * @brief       Allocate a memory block of the smallest size class that fits size.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[in]   size    size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osMemorySlabAlloc(osMemorySlabId_t ms_id, uint32_t size);
+
+/**
+ * @fn          osStatus_t osMemorySlabFree(osMemorySlabId_t ms_id, void *block)
+ * @brief       Return an allocated memory block back to a Memory Slab.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabFree(osMemorySlabId_t ms_id, void *block);
+
+/**
+ * @fn          osStatus_t osMemorySlabGetStats(osMemorySlabId_t ms_id, osMemorySlabStats_t *stats)
+ * @brief       Get fill and waste statistics of a Memory Slab.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[out]  stats   pointer to buffer for the statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabGetStats(osMemorySlabId_t ms_id, osMemorySlabStats_t *stats);
+
+/**
+ * @fn          osStatus_t osMemorySlabDelete(osMemorySlabId_t ms_id)
+ * @brief       Delete a Memory Slab object.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabDelete(osMemorySlabId_t ms_id);
+
+/*******************************************************************************
+ *  Heap
+ ******************************************************************************/
+
+/**
+ * @fn          osHeapId_t osHeapNew(uint32_t size, const osHeapAttr_t *attr)
+ * @brief       Create and Initialize a Heap object.
+ * @param[in]   size    heap size in bytes.
+ * @param[in]   attr    heap attributes.
+ * @return      heap ID for reference by other functions or NULL in case of error.
+ */
+osHeapId_t osHeapNew(uint32_t size, const osHeapAttr_t *attr);
+
+/**
+ * @fn          const char *osHeapGetName(osHeapId_t heap_id)
+ * @brief       Get name of a Heap object.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osHeapGetName(osHeapId_t heap_id);
+
+/**
+ * @fn          void *osHeapAlloc(osHeapId_t heap_id, uint32_t size)
+ * @brief       Allocate a memory block from a Heap in constant time.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[in]   size      size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osHeapAlloc(osHeapId_t heap_id, uint32_t size);
+
+/**
+ * @fn          osStatus_t osHeapFree(osHeapId_t heap_id, void *block)
+ * @brief       Return an allocated memory block back to a Heap in constant time.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[in]   block     address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapFree(osHeapId_t heap_id, void *block);
+
+/**
+ * @fn          osStatus_t osHeapGetStats(osHeapId_t heap_id, osHeapStats_t *stats)
+ * @brief       Get usage statistics of a Heap.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[out]  stats     pointer to buffer for the statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapGetStats(osHeapId_t heap_id, osHeapStats_t *stats);
+
+/**
+ * @fn          osStatus_t osHeapDelete(osHeapId_t heap_id)
+ * @brief       Delete a Heap object.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapDelete(osHeapId_t heap_id);
+
 
 /*******************************************************************************
  *  Mutex Management
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * Kernel event trace.
+ *
+ * The kernel library built with OS_TRACE=1 records kernel events into a ring
+ * buffer of OS_TRACE_SIZE records. The buffer image is a header followed by
+ * the records and can be saved by the application or dumped by a debugger,
+ * then converted to a timeline on the host (Tools/Trace/trace2json.c).
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+
+#define osTraceMagic                0x45435254U   ///< "TRCE"
+
+/* Event codes (bits 0..7 of the event word) */
+#define osTraceThreadSwitch         0x01U   ///< object: next thread, arg: previous thread
+#define osTraceServiceEnter         0x02U   ///< object: service function, arg: first parameter
+#define osTraceServiceExit          0x03U   ///< object: service function, arg: return value
+#define osTracePostProcess          0x04U   ///< object: kernel object, detail: object identifier
+#define osTraceTick                 0x05U   ///< arg: kernel tick count
+#define osTraceWaitEnter            0x06U   ///< object: thread, detail: thread state, arg: timeout
+#define osTraceWaitExit             0x07U   ///< object: thread, arg: return value
+
+#define osTraceCode(event)          ((event) & 0xFFU)
+#define osTraceDetail(event)        (((event) >> 8) & 0xFFU)
+
+/// Trace buffer header.
+typedef struct osTraceHeader_s {
+  uint32_t                      magic;  ///< osTraceMagic
+  uint32_t                       size;  ///< Number of records in the buffer
+  uint32_t                      count;  ///< Number of recorded events (wraps around)
+  uint32_t                       freq;  ///< System timer frequency [Hz]
+} osTraceHeader_t;
+
+/// Trace record.
+typedef struct osTraceRecord_s {
+  uint32_t                       time;  ///< System timer count
+  uint32_t                      event;  ///< Event code and detail
+  uint32_t                     object;  ///< Object address
+  uint32_t                        arg;  ///< Event argument
+} osTraceRecord_t;
+
+/**
+ * @brief       Get the trace buffer image.
+ * @param[out]  size  size of the buffer image in bytes.
+ * @return      trace buffer (osTraceHeader_t followed by the records) or NULL
+ *              if the kernel library is built without tracing.
+ * @note        Record number (count % size) is the next to be overwritten.
+ */
+const void *osTraceGetBuffer(uint32_t *size);
+
+#endif  // TRACE_H_
@@ -27,3 +27,22 @@ void osIdleThread(void *argument)
 
   }
 }
+
+/* OS Error Callback */
+uint32_t osKernelErrorNotify(uint32_t code, void *object_id)
+{
+  (void) object_id;
+
+  switch (code) {
+    case osKernelErrorStackOverflow:
+      /* Stack overflow detected for the thread (thread_id = object_id) */
+      break;
+
+    default:
+      break;
+  }
+
+  for (;;) {
+
+  }
+}
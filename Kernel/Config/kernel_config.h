@@ -47,11 +47,52 @@
 #endif
 
 //   </e>
+
+//   <q>Tickless Idle
+//   <i> Stops the Kernel Tick in the Idle Thread until the next timeout.
+#ifndef OS_TICKLESS_IDLE
+#define OS_TICKLESS_IDLE            0
+#endif
+
+//   <q>Thread CPU usage accounting
+//   <i> Accumulates the CPU time of each thread and the CPU load.
+#ifndef OS_CPU_USAGE
+#define OS_CPU_USAGE                0
+#endif
+
+//   <o>Global Dynamic Memory size [bytes] <0-1073741824:8>
+//   <i> Defines the size of the heap used for objects created without
+//   <i> user provided memory, that do not fit an object specific pool.
+//   <i> Default: 0 (no heap)
+#ifndef OS_DYNAMIC_MEM_SIZE
+#define OS_DYNAMIC_MEM_SIZE         0
+#endif
+
 // </h>
 
 // <h>Thread Configuration
 // =======================
 
+//   <e>Object specific Memory allocation
+//   <i> Enables Thread Control Blocks and default stacks from their own pools.
+#ifndef OS_THREAD_OBJ_MEM
+#define OS_THREAD_OBJ_MEM           0
+#endif
+
+//     <o>Number of user Threads <1-1000>
+//     <i> Defines maximum number of user threads that can be active at the same time.
+#ifndef OS_THREAD_NUM
+#define OS_THREAD_NUM               1
+#endif
+
+//     <o>Number of user Threads with default Stack size <0-1000>
+//     <i> Defines maximum number of user threads with default stack size.
+#ifndef OS_THREAD_DEF_STACK_NUM
+#define OS_THREAD_DEF_STACK_NUM     0
+#endif
+
+//   </e>
+
 //   <o>Default Thread Stack size [bytes] <96-1073741824:8>
 //   <i> Defines stack size for threads with zero stack size specified.
 //   <i> Default: 256
@@ -67,7 +108,7 @@
 #endif
 
 //   <q>Stack overrun checking
-//   <i> Enables stack overrun check at thread switch.
+//   <i> Enables stack overrun check at thread switch (GCC Cortex-M, GCC ARM7 and POSIX ports).
 //   <i> Enabling this option increases slightly the execution time of a thread switch.
 #ifndef OS_STACK_CHECK
 #define OS_STACK_CHECK              0
@@ -108,6 +149,109 @@
 #define OS_TIMER_THREAD_STACK_SIZE  256
 #endif
 
+//   <e>Object specific Memory allocation
+//   <i> Enables Timer Control Blocks from their own pool.
+#ifndef OS_TIMER_OBJ_MEM
+#define OS_TIMER_OBJ_MEM            0
+#endif
+
+//     <o>Number of Timer objects <1-1000>
+#ifndef OS_TIMER_NUM
+#define OS_TIMER_NUM                1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Event Flags Configuration
+// ============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Event Flags Control Blocks from their own pool.
+#ifndef OS_EVFLAGS_OBJ_MEM
+#define OS_EVFLAGS_OBJ_MEM          0
+#endif
+
+//     <o>Number of Event Flags objects <1-1000>
+#ifndef OS_EVFLAGS_NUM
+#define OS_EVFLAGS_NUM              1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Mutex Configuration
+// ======================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Mutex Control Blocks from their own pool.
+#ifndef OS_MUTEX_OBJ_MEM
+#define OS_MUTEX_OBJ_MEM            0
+#endif
+
+//     <o>Number of Mutex objects <1-1000>
+#ifndef OS_MUTEX_NUM
+#define OS_MUTEX_NUM                1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Semaphore Configuration
+// ==========================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Semaphore Control Blocks from their own pool.
+#ifndef OS_SEMAPHORE_OBJ_MEM
+#define OS_SEMAPHORE_OBJ_MEM        0
+#endif
+
+//     <o>Number of Semaphore objects <1-1000>
+#ifndef OS_SEMAPHORE_NUM
+#define OS_SEMAPHORE_NUM            1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Memory Pool Configuration
+// ============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Memory Pool Control Blocks from their own pool.
+#ifndef OS_MEMPOOL_OBJ_MEM
+#define OS_MEMPOOL_OBJ_MEM          0
+#endif
+
+//     <o>Number of Memory Pool objects <1-1000>
+#ifndef OS_MEMPOOL_NUM
+#define OS_MEMPOOL_NUM              1
+#endif
+
+//   </e>
+
+// </h>
+
+// <h>Message Queue Configuration
+// ==============================
+
+//   <e>Object specific Memory allocation
+//   <i> Enables Message Queue Control Blocks from their own pool.
+#ifndef OS_MSGQUEUE_OBJ_MEM
+#define OS_MSGQUEUE_OBJ_MEM         0
+#endif
+
+//     <o>Number of Message Queue objects <1-1000>
+#ifndef OS_MSGQUEUE_NUM
+#define OS_MSGQUEUE_NUM             1
+#endif
+
+//   </e>
+
 // </h>
 
 //------------- <<< end of configuration section >>> ---------------------------
@@ -0,0 +1,454 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * POSIX host port: exception handlers, context switch and OS Tick timer.
+ *
+ */
+
+#if (defined(__unix__) || defined(__APPLE__))
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include "Kernel/tick.h"
+#include "../kernel_lib.h"
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define TICK_CLOCK_FREQ               1000000000U   // Nanosecond resolution
+
+#define GetThreadContext(thread)      ((ThreadContext_t *)(uintptr_t)(thread)->stk)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/* Thread context placed at the top of the thread stack */
+typedef struct ThreadContext_s {
+  ucontext_t                        uc;
+  uint32_t                   func_addr;
+  uint32_t                  func_param;
+  uint32_t                   func_exit;
+} ThreadContext_t;
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+uint8_t irqLib;                             ///< Non weak library reference
+
+volatile uint32_t IRQ_Masked;
+volatile uint32_t IRQ_NestLevel;
+volatile uint8_t  IRQ_PendSV;
+volatile uint8_t  IRQ_PendST;
+
+uint32_t SystemCoreClock = TICK_CLOCK_FREQ;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static uint32_t tick_interval;              ///< Tick period [ns]
+static uint64_t tick_epoch;                 ///< Start of the first tick period [ns]
+static uint64_t tick_stopped;               ///< Time counted while the timer is stopped [ns]
+static uint32_t tick_ack;                   ///< Acknowledged tick periods
+static bool     tick_enabled;
+static volatile uint8_t tick_irq_masked;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static uint64_t ClockGetTime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (((uint64_t)ts.tv_sec * TICK_CLOCK_FREQ) + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @brief       Time counted by the OS Tick timer since setup.
+ */
+static uint64_t TickGetElapsed(void)
+{
+  if (tick_enabled) {
+    return (ClockGetTime() - tick_epoch);
+  }
+
+  return (tick_stopped);
+}
+
+/**
+ * @brief       Number of tick periods elapsed since the timer was started.
+ */
+static uint32_t TickGetPeriods(void)
+{
+  if (tick_interval == 0U) {
+    return (0U);
+  }
+
+  return ((uint32_t)(TickGetElapsed() / tick_interval));
+}
+
+static void TickTimerSet(uint32_t value, uint32_t interval)
+{
+  struct itimerval it;
+
+  it.it_value.tv_sec     = (time_t)(value / TICK_CLOCK_FREQ);
+  it.it_value.tv_usec    = (suseconds_t)((value % TICK_CLOCK_FREQ) / 1000U);
+  it.it_interval.tv_sec  = (time_t)(interval / TICK_CLOCK_FREQ);
+  it.it_interval.tv_usec = (suseconds_t)((interval % TICK_CLOCK_FREQ) / 1000U);
+
+  setitimer(ITIMER_REAL, &it, NULL);
+}
+
+/**
+ * @brief       Return to thread level.
+ * @return      true - returned, false - new interrupts are pending.
+ */
+static bool IRQ_Leave(void)
+{
+  IRQ_NestLevel = 0U;
+  __COMPILER_BARRIER();
+
+  if ((IRQ_PendST | IRQ_PendSV) == 0U) {
+    return (true);
+  }
+
+  IRQ_NestLevel = 1U;
+
+  return (false);
+}
+
+static void ContextSwitch(void)
+{
+  osThread_t *curr = osInfo.thread.run.curr;
+  osThread_t *next = osInfo.thread.run.next;
+
+  if (curr != next) {
+    osInfo.thread.run.curr = next;
+    if (curr == NULL) {
+      /* First switch: the main() context is abandoned */
+      setcontext(&GetThreadContext(next)->uc);
+    }
+    else {
+      /* The context is saved in the thread stack, only the sentinel can be checked */
+      if ((osConfig.flags & osConfigStackCheck) != 0U) {
+        (void)krnThreadStackCheck(curr);
+      }
+      swapcontext(&GetThreadContext(curr)->uc, &GetThreadContext(next)->uc);
+    }
+  }
+}
+
+static void ThreadStart(void)
+{
+  ThreadContext_t *ctx = GetThreadContext(ThreadGetRunning());
+
+  /* The thread is entered from handler mode */
+  if (!IRQ_Leave()) {
+    IRQ_Return();
+  }
+
+  ((osThreadFunc_t)(uintptr_t)ctx->func_addr)((void *)(uintptr_t)ctx->func_param);
+  ((void (*)(void))(uintptr_t)ctx->func_exit)();
+}
+
+static void SysTick_Signal(int sig)
+{
+  int err = errno;
+  (void)sig;
+
+  if (tick_irq_masked == 0U) {
+    IRQ_PendST = 1U;
+    if ((IRQ_Masked == 0U) && (IRQ_NestLevel == 0U)) {
+      IRQ_NestLevel = 1U;
+      IRQ_Return();
+    }
+  }
+
+  errno = err;
+}
+
+/*******************************************************************************
+ *  function implementations (scope: module-exported)
+ ******************************************************************************/
+
+/**
+ * @brief       Leave handler mode: process pending OS Tick and Service Call
+ *              requests and switch to the next thread.
+ */
+void IRQ_Return(void)
+{
+  do {
+    if (IRQ_PendST != 0U) {
+      IRQ_PendST = 0U;
+      SysTick_Handler();
+    }
+    if (IRQ_PendSV != 0U) {
+      PendSV_Handler();
+    }
+    ContextSwitch();
+  } while (!IRQ_Leave());
+}
+
+/**
+ * @brief       Run an interrupt handler as if its interrupt was taken.
+ * @param[in]   handler   interrupt handler.
+ */
+void IRQ_Call(IRQHandler_t handler)
+{
+  uint32_t level = IRQ_NestLevel;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  handler();
+
+  if ((level == 0U) && (IRQ_Masked == 0U)) {
+    IRQ_Return();
+  }
+  else {
+    IRQ_NestLevel = level;
+  }
+}
+
+void SysTick_Handler(void)
+{
+  uint32_t periods = TickGetPeriods() - tick_ack;
+
+  /* Catch up with the tick periods lost while the process was not running */
+  for (; periods != 0U; --periods) {
+    osTick_Handler();
+  }
+}
+
+/**
+ * @brief       Suspend the process until an interrupt becomes pending.
+ */
+void IRQ_Wait(void)
+{
+  sigset_t set;
+  sigset_t old;
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGALRM);
+  sigprocmask(SIG_BLOCK, &set, &old);
+
+  if ((IRQ_PendST | IRQ_PendSV) == 0U) {
+    sigsuspend(&old);
+  }
+
+  sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
+void PendSV_Handler(void)
+{
+  IRQ_PendSV = 0U;
+  osPendSV_Handler();
+}
+
+/**
+ * @brief       Initialize thread context.
+ * @param[in]   attr        stack attributes.
+ * @param[in]   privileged  ignored.
+ * @return      address of the thread context.
+ */
+uint32_t StackInit(StackAttr_t *attr, bool privileged)
+{
+  ThreadContext_t *ctx;
+  uintptr_t        top;
+  (void)privileged;
+
+  top = ((uintptr_t)attr->stk_mem + attr->stk_size - sizeof(ThreadContext_t)) & ~(uintptr_t)15U;
+  ctx = (ThreadContext_t *)top;
+
+  ctx->func_addr  = attr->func_addr;
+  ctx->func_param = attr->func_param;
+  ctx->func_exit  = attr->func_exit;
+
+  getcontext(&ctx->uc);
+  ctx->uc.uc_link          = NULL;
+  ctx->uc.uc_stack.ss_sp   = (void *)(uintptr_t)attr->stk_mem;
+  ctx->uc.uc_stack.ss_size = top - (uintptr_t)attr->stk_mem;
+  makecontext(&ctx->uc, ThreadStart, 0);
+
+  return ((uint32_t)top);
+}
+
+/*******************************************************************************
+ *  OS Tick timer
+ ******************************************************************************/
+
+/**
+ * @brief       Setup OS Tick timer to generate periodic RTOS Kernel Ticks
+ * @param[in]   freq      tick frequency in Hz
+ * @param[in]   handler   tick IRQ handler
+ * @return      0 on success, -1 on error.
+ */
+__WEAK int32_t osTickSetup(uint32_t freq, IRQHandler_t handler)
+{
+  struct sigaction sa;
+  (void)handler;
+
+  if ((freq == 0U) || (freq > 1000000U)) {
+    return (-1);
+  }
+
+  sa.sa_handler = SysTick_Signal;
+  sa.sa_flags   = SA_RESTART | SA_NODEFER;
+  sigemptyset(&sa.sa_mask);
+  if (sigaction(SIGALRM, &sa, NULL) != 0) {
+    return (-1);
+  }
+
+  TickTimerSet(0U, 0U);
+
+  tick_interval = osTickGetClock() / freq;
+  tick_enabled  = false;
+  tick_stopped  = 0U;
+  tick_ack      = 0U;
+  IRQ_PendST    = 0U;
+
+  return (0);
+}
+
+/**
+ * @brief       Enable OS Tick timer interrupt
+ */
+__WEAK void osTickEnable(void)
+{
+  uint32_t remain;
+
+  if (tick_enabled) {
+    return;
+  }
+
+  tick_epoch   = ClockGetTime() - tick_stopped;
+  tick_enabled = true;
+
+  if (TickGetPeriods() != tick_ack) {
+    IRQ_PendST = 1U;
+  }
+
+  remain = tick_interval - (uint32_t)(tick_stopped % tick_interval);
+  if (remain < 1000U) {
+    remain = 1000U;
+  }
+  TickTimerSet(remain, tick_interval);
+}
+
+/**
+ * @brief       Disable OS Tick timer interrupt
+ */
+__WEAK void osTickDisable(void)
+{
+  if (!tick_enabled) {
+    return;
+  }
+
+  TickTimerSet(0U, 0U);
+
+  tick_stopped = ClockGetTime() - tick_epoch;
+  tick_enabled = false;
+  IRQ_PendST   = 0U;
+}
+
+/**
+ * @brief       Enable generation of RTOS Kernel Tick interrupts
+ */
+__WEAK void osTickEnableIRQ(void)
+{
+  tick_irq_masked = 0U;
+}
+
+/**
+ * @brief       Disable generation of RTOS Kernel Tick interrupts
+ */
+__WEAK void osTickDisableIRQ(void)
+{
+  tick_irq_masked = 1U;
+}
+
+/**
+ * @brief       Acknowledge execution of OS Tick timer interrupt
+ */
+__WEAK void osTickAcknowledgeIRQ(void)
+{
+  tick_ack++;
+}
+
+/**
+ * @brief       Get OS Tick timer clock frequency
+ * @return      OS Tick timer clock frequency in Hz
+ */
+__WEAK uint32_t osTickGetClock(void)
+{
+  return (SystemCoreClock);
+}
+
+/**
+ * @brief       Get OS Tick timer interval reload value
+ * @return      OS Tick timer interval reload value
+ */
+__WEAK uint32_t osTickGetInterval(void)
+{
+  return (tick_interval);
+}
+
+/**
+ * @brief       Get OS Tick timer counter value
+ * @return      OS Tick timer counter value
+ */
+__WEAK uint32_t osTickGetCount(void)
+{
+  if (tick_interval == 0U) {
+    return (0U);
+  }
+
+  return ((uint32_t)(TickGetElapsed() % tick_interval));
+}
+
+/**
+ * @brief       Get OS Tick timer overflow status
+ * @return      OS Tick overflow status (1 - overflow, 0 - no overflow).
+ */
+__WEAK uint32_t osTickGetOverflow(void)
+{
+  return ((TickGetPeriods() != tick_ack) ? 1U : 0U);
+}
+
+#endif  /* __unix__ || __APPLE__ */
+
+/*------------------------------ End of file ---------------------------------*/
@@ -88,19 +88,27 @@ typedef struct StackAttr_s {
 
 #include "arch_kmx32.h"
 
+#elif (defined(__unix__) || defined(__APPLE__))
+
+#include "arch_posix.h"
+
 #else
   #error Unknown target.
 #endif
 
 #define FILL_STACK_VALUE              (0xFFFFFFFFU)
+#define STACK_MAGIC_WORD              (0xE25A2EA5U)
 /* Minimal thread stack size in bytes */
-#define MIN_THREAD_STK_SIZE           64U
+#ifndef MIN_THREAD_STK_SIZE
+#define MIN_THREAD_STK_SIZE           osThreadStackSizeMin
+#endif
 
-#define SVC_0(func)                                   (uint32_t)svc_0((uint32_t)(func))
-#define SVC_1(param1, func)                           (uint32_t)svc_1((uint32_t)(param1), (uint32_t)(func))
-#define SVC_2(param1, param2, func)                   (uint32_t)svc_2((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(func))
-#define SVC_3(param1, param2, param3, func)           (uint32_t)svc_3((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(param3), (uint32_t)(func))
-#define SVC_4(param1, param2, param3, param4, func)   (uint32_t)svc_4((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(param3), (uint32_t)(param4), (uint32_t)(func))
+/* Service Calls, TRACE_SERVICE is defined by the kernel library */
+#define SVC_0(func)                                   TRACE_SERVICE(func, 0U,     (uint32_t)svc_0((uint32_t)(func)))
+#define SVC_1(param1, func)                           TRACE_SERVICE(func, param1, (uint32_t)svc_1((uint32_t)(param1), (uint32_t)(func)))
+#define SVC_2(param1, param2, func)                   TRACE_SERVICE(func, param1, (uint32_t)svc_2((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(func)))
+#define SVC_3(param1, param2, param3, func)           TRACE_SERVICE(func, param1, (uint32_t)svc_3((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(param3), (uint32_t)(func)))
+#define SVC_4(param1, param2, param3, param4, func)   TRACE_SERVICE(func, param1, (uint32_t)svc_4((uint32_t)(param1), (uint32_t)(param2), (uint32_t)(param3), (uint32_t)(param4), (uint32_t)(func)))
 
 #endif  // _ARCH_H_
 
@@ -82,6 +82,8 @@
                                       __disable_irq();
 #define END_CRITICAL_SECTION          __set_PRIMASK(primask);
 
+#define WaitForInterrupt()            __WFI()
+
 /*******************************************************************************
  *  typedefs and structures
  ******************************************************************************/
@@ -239,6 +241,153 @@ bool IsIrqMasked(void)
 #endif
 }
 
+/**
+ * @fn          bool AtomicCompareSwap(volatile uint32_t *, uint32_t, uint32_t)
+ * @brief       Replace the contents of a word if it holds an expected value.
+ * @param[in]   mem       address of the word.
+ * @param[in]   expected  value the word must hold.
+ * @param[in]   desired   new value of the word.
+ * @return      true=replaced, false=value differs or the swap is not possible
+ *              in the current mode (unprivileged thread on ARMv6-M).
+ */
+__STATIC_FORCEINLINE
+bool AtomicCompareSwap(volatile uint32_t *mem, uint32_t expected, uint32_t desired)
+{
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) || \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) || \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)) || \
+       (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  /* Exception entry and return clear the exclusive monitor */
+  do {
+    if (__LDREXW(mem) != expected) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXW(desired, mem) != 0U);
+  __COMPILER_BARRIER();
+
+  return (true);
+#else
+  bool ret;
+
+  /* CPSID is ignored in unprivileged mode */
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem == expected);
+  if (ret) {
+    *mem = desired;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+#endif
+}
+
+/**
+ * @fn          bool AtomicDecrementNonZero16(volatile uint16_t *)
+ * @brief       Decrement a counter if it is not zero.
+ * @param[in]   mem   address of the counter.
+ * @return      true=decremented, false=counter is zero or the operation is
+ *              not possible in the current mode (unprivileged thread on ARMv6-M).
+ */
+__STATIC_FORCEINLINE
+bool AtomicDecrementNonZero16(volatile uint16_t *mem)
+{
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) || \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) || \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)) || \
+       (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  uint16_t val;
+
+  do {
+    val = __LDREXH(mem);
+    if (val == 0U) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXH((uint16_t)(val - 1U), mem) != 0U);
+  __COMPILER_BARRIER();
+
+  return (true);
+#else
+  bool ret;
+
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem != 0U);
+  if (ret) {
+    *mem = *mem - 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+#endif
+}
+
+/**
+ * @fn          bool AtomicIncrementLimit16(volatile uint16_t *, uint16_t, void *const volatile *, const void *)
+ * @brief       Increment a counter if it is below a limit and a guard pointer
+ *              holds the given value.
+ * @param[in]   mem     address of the counter.
+ * @param[in]   limit   maximum value of the counter.
+ * @param[in]   guard   address of the guard pointer.
+ * @param[in]   value   value the guard pointer must hold.
+ * @return      true=incremented, false=condition not met or the operation is
+ *              not possible in the current mode (unprivileged thread on ARMv6-M).
+ */
+__STATIC_FORCEINLINE
+bool AtomicIncrementLimit16(volatile uint16_t *mem, uint16_t limit,
+                            void *const volatile *guard, const void *value)
+{
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) || \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) || \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)) || \
+       (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  uint16_t val;
+
+  /* The guard is read inside the exclusive access: an exception that could
+     change it clears the monitor and the store fails */
+  do {
+    val = __LDREXH(mem);
+    __COMPILER_BARRIER();
+    if ((val >= limit) || (*guard != value)) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXH((uint16_t)(val + 1U), mem) != 0U);
+  __COMPILER_BARRIER();
+
+  return (true);
+#else
+  bool ret;
+
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = ((*mem < limit) && (*guard == value));
+  if (ret) {
+    *mem = *mem + 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+#endif
+}
+
 __STATIC_INLINE
 void SystemIsrInit(void)
 {
@@ -81,6 +81,97 @@ bool IsIrqMode(void)
   return ((mode & PSW_IL_Msk) != 0U);
 }
 
+/**
+ * @fn          bool AtomicCompareSwap(volatile uint32_t *, uint32_t, uint32_t)
+ * @brief       Replace the contents of a word if it holds an expected value.
+ * @param[in]   mem       address of the word.
+ * @param[in]   expected  value the word must hold.
+ * @param[in]   desired   new value of the word.
+ * @return      true=replaced, false=value differs or the swap is not possible
+ *              in the current mode (user mode).
+ */
+__STATIC_INLINE
+bool AtomicCompareSwap(volatile uint32_t *mem, uint32_t expected, uint32_t desired)
+{
+  bool ret;
+
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem == expected);
+  if (ret) {
+    *mem = desired;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
+/**
+ * @fn          bool AtomicDecrementNonZero16(volatile uint16_t *)
+ * @brief       Decrement a counter if it is not zero.
+ * @param[in]   mem   address of the counter.
+ * @return      true=decremented, false=counter is zero or the operation is
+ *              not possible in the current mode (user mode).
+ */
+__STATIC_INLINE
+bool AtomicDecrementNonZero16(volatile uint16_t *mem)
+{
+  bool ret;
+
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem != 0U);
+  if (ret) {
+    *mem = *mem - 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
+/**
+ * @fn          bool AtomicIncrementLimit16(volatile uint16_t *, uint16_t, void *const volatile *, const void *)
+ * @brief       Increment a counter if it is below a limit and a guard pointer
+ *              holds the given value.
+ * @param[in]   mem     address of the counter.
+ * @param[in]   limit   maximum value of the counter.
+ * @param[in]   guard   address of the guard pointer.
+ * @param[in]   value   value the guard pointer must hold.
+ * @return      true=incremented, false=condition not met or the operation is
+ *              not possible in the current mode (user mode).
+ */
+__STATIC_INLINE
+bool AtomicIncrementLimit16(volatile uint16_t *mem, uint16_t limit,
+                            void *const volatile *guard, const void *value)
+{
+  bool ret;
+
+  if (!IsPrivileged()) {
+    return (false);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = ((*mem < limit) && (*guard == value));
+  if (ret) {
+    *mem = *mem + 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
 extern uint8_t IRQ_PendSV;
 
 /**
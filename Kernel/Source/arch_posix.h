@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * POSIX host port.
+ *
+ * The kernel runs as a single process. Threads are ucontext_t contexts,
+ * the kernel tick is SIGALRM and the interrupt mask is a software flag, so
+ * the interrupt handlers never run concurrently with a critical section.
+ * Kernel objects and thread stacks keep 32-bit addresses in the control
+ * blocks: build with -m32, or with -no-pie on a 64-bit host and allocate
+ * all kernel objects statically.
+ */
+
+#ifndef ARCH_POSIX_H_
+#define ARCH_POSIX_H_
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ *  defines and macros
+ ******************************************************************************/
+
+#ifndef   __ASM
+  #define __ASM                       __asm
+#endif
+#ifndef   __INLINE
+  #define __INLINE                    inline
+#endif
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE             static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#endif
+#ifndef   __WEAK
+  #define __WEAK                      __attribute__((weak))
+#endif
+#ifndef   __COMPILER_BARRIER
+  #define __COMPILER_BARRIER()        __ASM volatile("":::"memory")
+#endif
+
+#define INIT_EXC_RETURN               0UL
+#define OS_TICK_HANDLER               SysTick_Handler
+
+#define SystemIsrInit()
+#define setPrivilegedMode(flag)
+
+#define BEGIN_CRITICAL_SECTION        uint32_t mode = DisableIRQ();
+#define END_CRITICAL_SECTION          RestoreIRQ(mode);
+
+#define WaitForInterrupt()            IRQ_Wait()
+
+/*******************************************************************************
+ *  exported variables
+ ******************************************************************************/
+
+extern volatile uint32_t IRQ_Masked;    ///< Software interrupt mask (PRIMASK)
+extern volatile uint32_t IRQ_NestLevel; ///< Handler mode indicator
+extern volatile uint8_t  IRQ_PendSV;    ///< Pending SV (Service Call) flag
+extern volatile uint8_t  IRQ_PendST;    ///< Pending OS Tick flag
+
+/*******************************************************************************
+ *  exported function prototypes
+ ******************************************************************************/
+
+/**
+ * @brief       Leave handler mode: process pending OS Tick and Service Call
+ *              requests and switch to the next thread.
+ */
+extern void IRQ_Return(void);
+
+/**
+ * @brief       Suspend the process until an interrupt becomes pending.
+ */
+extern void IRQ_Wait(void);
+
+/**
+ * @brief       Run an interrupt handler as if its interrupt was taken.
+ * @param[in]   handler   interrupt handler.
+ */
+extern void IRQ_Call(void (*handler)(void));
+
+/**
+ * @brief       Initialize thread context.
+ * @param[in]   attr        stack attributes.
+ * @param[in]   privileged  ignored.
+ * @return      address of the thread context.
+ */
+extern uint32_t StackInit(StackAttr_t *attr, bool privileged);
+
+/*******************************************************************************
+ *  exported functions
+ ******************************************************************************/
+
+/**
+ * @fn          uint8_t __CLZ(uint32_t)
+ * @brief       Count leading zeros
+ * @param[in]   value  Value to count the leading zeros
+ * @return      number of leading zeros in value
+ */
+__STATIC_FORCEINLINE
+uint8_t __CLZ(uint32_t value)
+{
+  if (value == 0U) {
+    return (32U);
+  }
+
+  return ((uint8_t)__builtin_clz(value));
+}
+
+/**
+ * @fn          uint32_t DisableIRQ(void)
+ * @brief       Mask interrupts.
+ * @return      previous interrupt mask.
+ */
+__STATIC_FORCEINLINE
+uint32_t DisableIRQ(void)
+{
+  uint32_t mode = IRQ_Masked;
+
+  IRQ_Masked = 1U;
+  __COMPILER_BARRIER();
+
+  return (mode);
+}
+
+/**
+ * @fn          void RestoreIRQ(uint32_t)
+ * @brief       Restore interrupt mask and take the pending interrupts.
+ * @param[in]   mode  interrupt mask returned by DisableIRQ.
+ */
+__STATIC_FORCEINLINE
+void RestoreIRQ(uint32_t mode)
+{
+  __COMPILER_BARRIER();
+  IRQ_Masked = mode;
+
+  if ((mode == 0U) && (IRQ_NestLevel == 0U) && ((IRQ_PendST | IRQ_PendSV) != 0U)) {
+    IRQ_NestLevel = 1U;
+    IRQ_Return();
+  }
+}
+
+/**
+ * @fn          bool IsPrivileged(void)
+ * @brief       Check if running Privileged
+ *
+ * @return      true=privileged, false=unprivileged
+ */
+__STATIC_INLINE
+bool IsPrivileged(void)
+{
+  return (true);
+}
+
+/**
+ * @fn          bool IsIrqMode(void)
+ * @brief       Check if in IRQ Mode
+ * @return      true=IRQ, false=thread
+ */
+__STATIC_INLINE
+bool IsIrqMode(void)
+{
+  return (IRQ_NestLevel != 0U);
+}
+
+/**
+ * @fn          bool IsIrqMasked(void)
+ * @brief       Check if IRQ is Masked
+ * @return      true=masked, false=not masked
+ */
+__STATIC_INLINE
+bool IsIrqMasked(void)
+{
+  return (IRQ_Masked != 0U);
+}
+
+/**
+ * @fn          bool AtomicCompareSwap(volatile uint32_t *, uint32_t, uint32_t)
+ * @brief       Replace the contents of a word if it holds an expected value.
+ * @param[in]   mem       address of the word.
+ * @param[in]   expected  value the word must hold.
+ * @param[in]   desired   new value of the word.
+ * @return      true=replaced, false=value differs.
+ */
+__STATIC_INLINE
+bool AtomicCompareSwap(volatile uint32_t *mem, uint32_t expected, uint32_t desired)
+{
+  bool ret;
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem == expected);
+  if (ret) {
+    *mem = desired;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
+/**
+ * @fn          bool AtomicDecrementNonZero16(volatile uint16_t *)
+ * @brief       Decrement a counter if it is not zero.
+ * @param[in]   mem   address of the counter.
+ * @return      true=decremented, false=counter is zero.
+ */
+__STATIC_INLINE
+bool AtomicDecrementNonZero16(volatile uint16_t *mem)
+{
+  bool ret;
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = (*mem != 0U);
+  if (ret) {
+    *mem = *mem - 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
+/**
+ * @fn          bool AtomicIncrementLimit16(volatile uint16_t *, uint16_t, void *const volatile *, const void *)
+ * @brief       Increment a counter if it is below a limit and a guard pointer
+ *              holds the given value.
+ * @param[in]   mem     address of the counter.
+ * @param[in]   limit   maximum value of the counter.
+ * @param[in]   guard   address of the guard pointer.
+ * @param[in]   value   value the guard pointer must hold.
+ * @return      true=incremented, false=condition not met.
+ */
+__STATIC_INLINE
+bool AtomicIncrementLimit16(volatile uint16_t *mem, uint16_t limit,
+                            void *const volatile *guard, const void *value)
+{
+  bool ret;
+
+  BEGIN_CRITICAL_SECTION
+
+  ret = ((*mem < limit) && (*guard == value));
+  if (ret) {
+    *mem = *mem + 1U;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ret);
+}
+
+/**
+ * @fn          void PendServCallReq(void)
+ * @brief       Set Pending SV (Service Call) Flag.
+ */
+__STATIC_FORCEINLINE
+void PendServCallReq(void)
+{
+  IRQ_PendSV = 1U;
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_0(uint32_t func)
+{
+  uint32_t ret;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  ret = (uint32_t)((uintptr_t (*)(void))(uintptr_t)func)();
+  IRQ_Return();
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_1(uint32_t param1, uint32_t func)
+{
+  uint32_t ret;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  ret = (uint32_t)((uintptr_t (*)(uintptr_t))(uintptr_t)func)(param1);
+  IRQ_Return();
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_2(uint32_t param1, uint32_t param2, uint32_t func)
+{
+  uint32_t ret;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  ret = (uint32_t)((uintptr_t (*)(uintptr_t, uintptr_t))(uintptr_t)func)(param1, param2);
+  IRQ_Return();
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_3(uint32_t param1, uint32_t param2, uint32_t param3, uint32_t func)
+{
+  uint32_t ret;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  ret = (uint32_t)((uintptr_t (*)(uintptr_t, uintptr_t, uintptr_t))(uintptr_t)func)(param1, param2, param3);
+  IRQ_Return();
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_4(uint32_t param1, uint32_t param2, uint32_t param3, uint32_t param4, uint32_t func)
+{
+  uint32_t ret;
+
+  IRQ_NestLevel = 1U;
+  __COMPILER_BARRIER();
+  ret = (uint32_t)((uintptr_t (*)(uintptr_t, uintptr_t, uintptr_t, uintptr_t))(uintptr_t)func)(param1, param2, param3, param4);
+  IRQ_Return();
+
+  return (ret);
+}
+
+#endif /* ARCH_POSIX_H_ */
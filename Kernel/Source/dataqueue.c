@@ -35,59 +35,288 @@
  *  Helper functions
  ******************************************************************************/
 
-static bool DataPut(osDataQueue_t *dq, const void *data_ptr)
+/**
+ * @brief       Get the number of free data slots in the ring buffer.
+ * @param[in]   dq  data queue object.
+ * @return      number of data.
+ */
+__STATIC_INLINE
+uint32_t DataSpace(osDataQueue_t *dq)
 {
-  bool status = false;
+  return (dq->max_data_count - dq->data_count - dq->put_pending - dq->get_pending);
+}
+
+/**
+ * @brief       Reserve slots for up to count data.
+ * @param[in]   dq      data queue object.
+ * @param[in]   count   pointer to number of data, reduced to the reserved data.
+ * @return      ring buffer offset of the reserved slots.
+ */
+static uint32_t DataPutReserve(osDataQueue_t *dq, uint32_t *count)
+{
+  uint32_t head;
 
   BEGIN_CRITICAL_SECTION
 
-  if (dq->data_count != dq->max_data_count) {
-    memcpy(&dq->dq_mem[dq->head], data_ptr, dq->data_size);
-    dq->head += dq->data_size;
-    if (dq->head >= dq->data_limit) {
-      dq->head = 0U;
-    }
-    dq->data_count++;
-    status = true;
+  if (*count > DataSpace(dq)) {
+    *count = DataSpace(dq);
   }
+  head = dq->head;
+  dq->head += *count * dq->data_size;
+  if (dq->head >= dq->data_limit) {
+    dq->head -= dq->data_limit;
+  }
+  dq->put_pending += *count;
+  dq->put_nest++;
 
   END_CRITICAL_SECTION
 
-  return (status);
+  return (head);
 }
 
-static bool DataGet(osDataQueue_t *dq, void *data_ptr)
+/**
+ * @brief       Publish the reserved data, a nested sender leaves them to the
+ *              sender it interrupted.
+ * @param[in]   dq  data queue object.
+ */
+static void DataPutPublish(osDataQueue_t *dq)
 {
-  bool status = false;
+  BEGIN_CRITICAL_SECTION
+
+  dq->put_nest--;
+  if (dq->put_nest == 0U) {
+    dq->data_count += dq->put_pending;
+    dq->put_pending = 0U;
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Take up to count data.
+ * @param[in]   dq      data queue object.
+ * @param[in]   count   pointer to number of data, reduced to the taken data.
+ * @return      ring buffer offset of the taken data.
+ */
+static uint32_t DataGetTake(osDataQueue_t *dq, uint32_t *count)
+{
+  uint32_t tail;
 
   BEGIN_CRITICAL_SECTION
 
-  if (dq->data_count != 0U) {
-    memcpy(data_ptr, &dq->dq_mem[dq->tail], dq->data_size);
-    dq->data_count--;
-    dq->tail += dq->data_size;
-    if (dq->tail >= dq->data_limit) {
-      dq->tail = 0U;
-    }
-    status = true;
+  if (*count > dq->data_count) {
+    *count = dq->data_count;
   }
+  tail = dq->tail;
+  dq->tail += *count * dq->data_size;
+  if (dq->tail >= dq->data_limit) {
+    dq->tail -= dq->data_limit;
+  }
+  dq->data_count -= *count;
+  dq->get_pending += *count;
+  dq->get_nest++;
 
   END_CRITICAL_SECTION
 
-  return (status);
+  return (tail);
+}
+
+/**
+ * @brief       Free the slots of the taken data, a nested receiver leaves
+ *              them to the receiver it interrupted.
+ * @param[in]   dq  data queue object.
+ */
+static void DataGetRelease(osDataQueue_t *dq)
+{
+  BEGIN_CRITICAL_SECTION
+
+  dq->get_nest--;
+  if (dq->get_nest == 0U) {
+    dq->get_pending = 0U;
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Copy up to count data into the ring buffer.
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data put into the ring buffer.
+ */
+static uint32_t DataPutN(osDataQueue_t *dq, const void *data_ptr, uint32_t count)
+{
+  const uint8_t *src = data_ptr;
+  uint32_t       head;
+  uint32_t       size;
+  uint32_t       span;
+
+  head = DataPutReserve(dq, &count);
+
+  if (count != 0U) {
+    /* Copy up to the end of the ring, then from its start */
+    size = count * dq->data_size;
+    span = dq->data_limit - head;
+    if (span > size) {
+      span = size;
+    }
+    memcpy(&dq->dq_mem[head], src, span);
+    memcpy(&dq->dq_mem[0], &src[span], size - span);
+  }
+
+  DataPutPublish(dq);
+
+  return (count);
+}
+
+/**
+ * @brief       Copy up to count data out of the ring buffer.
+ * @param[in]   dq        data queue object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   count     number of data the buffer can hold.
+ * @return      number of data got from the ring buffer.
+ */
+static uint32_t DataGetN(osDataQueue_t *dq, void *data_ptr, uint32_t count)
+{
+  uint8_t  *dst = data_ptr;
+  uint32_t  tail;
+  uint32_t  size;
+  uint32_t  span;
+
+  tail = DataGetTake(dq, &count);
+
+  if (count != 0U) {
+    /* Copy up to the end of the ring, then from its start */
+    size = count * dq->data_size;
+    span = dq->data_limit - tail;
+    if (span > size) {
+      span = size;
+    }
+    memcpy(dst, &dq->dq_mem[tail], span);
+    memcpy(&dst[span], &dq->dq_mem[0], size - span);
+  }
+
+  DataGetRelease(dq);
+
+  return (count);
 }
 
 static void DataReset(osDataQueue_t *dq)
 {
   BEGIN_CRITICAL_SECTION
 
+  /* Discard the published data only, copies in progress keep their slots */
+  dq->tail += dq->data_count * dq->data_size;
+  if (dq->tail >= dq->data_limit) {
+    dq->tail -= dq->data_limit;
+  }
   dq->data_count = 0U;
-  dq->head       = 0U;
-  dq->tail       = 0U;
 
   END_CRITICAL_SECTION
 }
 
+/**
+ * @brief       Wake up a Thread waiting in Put/Get or PutN/GetN.
+ * @param[in]   thread  thread object.
+ * @param[in]   count   number of data moved for the thread.
+ */
+static void DataWaitExit(osThread_t *thread, uint32_t count)
+{
+  if (thread->winfo.dataque.count == 0U) {
+    krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
+  }
+  else {
+    krnThreadWaitExit(thread, count, DISPATCH_NO);
+  }
+}
+
+/**
+ * @brief       Pass data to Threads waiting to receive, queue the rest.
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data sent.
+ */
+static uint32_t DataSend(osDataQueue_t *dq, const void *data_ptr, uint32_t count)
+{
+  const uint8_t *src = data_ptr;
+  osThread_t    *thread;
+  uint32_t       num;
+  uint32_t       sent = 0U;
+
+  /* Threads wait to receive only while the ring buffer is empty */
+  while ((sent != count) && !isQueueEmpty(&dq->wait_get_queue)) {
+    thread = GetThreadByQueue(dq->wait_get_queue.next);
+    num = thread->winfo.dataque.count;
+    if (num == 0U) {
+      num = 1U;
+    }
+    if (num > (count - sent)) {
+      num = count - sent;
+    }
+    memcpy((void *)thread->winfo.dataque.data_ptr, &src[sent * dq->data_size], num * dq->data_size);
+    sent += num;
+    DataWaitExit(thread, num);
+  }
+
+  if (sent != count) {
+    sent += DataPutN(dq, &src[sent * dq->data_size], count - sent);
+  }
+
+  return (sent);
+}
+
+/**
+ * @brief       Refill the ring buffer from Threads waiting to send.
+ * @param[in]   dq  data queue object.
+ * @return      true if a Thread was woken up.
+ */
+static bool DataWakePut(osDataQueue_t *dq)
+{
+  osThread_t *thread;
+  uint32_t    num;
+  bool        woken = false;
+
+  while (!isQueueEmpty(&dq->wait_put_queue)) {
+    thread = GetThreadByQueue(dq->wait_put_queue.next);
+    num = thread->winfo.dataque.count;
+    num = DataPutN(dq, (const void *)thread->winfo.dataque.data_ptr, (num == 0U) ? 1U : num);
+    if (num == 0U) {
+      break;
+    }
+    DataWaitExit(thread, num);
+    woken = true;
+  }
+
+  return (woken);
+}
+
+/**
+ * @brief       Drain the ring buffer into Threads waiting to receive.
+ * @param[in]   dq  data queue object.
+ * @return      true if a Thread was woken up.
+ */
+static bool DataWakeGet(osDataQueue_t *dq)
+{
+  osThread_t *thread;
+  uint32_t    num;
+  bool        woken = false;
+
+  while (!isQueueEmpty(&dq->wait_get_queue)) {
+    thread = GetThreadByQueue(dq->wait_get_queue.next);
+    num = thread->winfo.dataque.count;
+    num = DataGetN(dq, (void *)thread->winfo.dataque.data_ptr, (num == 0U) ? 1U : num);
+    if (num == 0U) {
+      break;
+    }
+    DataWaitExit(thread, num);
+    woken = true;
+  }
+
+  return (woken);
+}
+
 /*******************************************************************************
  *  Service Calls
  ******************************************************************************/
@@ -122,6 +351,10 @@ static osDataQueueId_t svcDataQueueNew(uint32_t data_count, uint32_t data_size,
   dq->data_limit     = data_limit;
   dq->head           = 0U;
   dq->tail           = 0U;
+  dq->put_pending    = 0U;
+  dq->get_pending    = 0U;
+  dq->put_nest       = 0U;
+  dq->get_nest       = 0U;
   dq->dq_mem         = attr->dq_mem;
 
   QueueReset(&dq->wait_put_queue);
@@ -145,40 +378,37 @@ static const char *svcDataQueueGetName(osDataQueueId_t dq_id)
 
 static osStatus_t svcDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint32_t timeout)
 {
-  osStatus_t     status;
-  osThread_t    *thread;
-  osDataQueue_t *dq = dq_id;
+  osDataQueue_t   *dq = dq_id;
+  winfo_dataque_t *winfo;
+  osStatus_t       status;
 
   /* Check parameters */
   if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL)) {
     return (osErrorParameter);
   }
 
-  /* Check if Thread is waiting to receive a data */
+  /* Try to pass a data to a waiting Thread or put it into Queue */
   if (!isQueueEmpty(&dq->wait_get_queue)) {
-    /* Wakeup waiting Thread with highest Priority */
-    thread = GetThreadByQueue(dq->wait_get_queue.next);
-    krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-    memcpy((void *)thread->winfo.dataque.data_ptr, data_ptr, dq->data_size);
+    DataSend(dq, data_ptr, 1U);
+    SchedDispatch(NULL);
+    status = osOK;
+  }
+  else if (DataPutN(dq, data_ptr, 1U) != 0U) {
     status = osOK;
   }
   else {
-    /* Try to put a data into Queue */
-    if (DataPut(dq, data_ptr) != false) {
-      status = osOK;
+    /* No memory available */
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      status = krnThreadWaitEnter(ThreadWaitingQueuePut, &dq->wait_put_queue, timeout);
+      if (status != osErrorTimeout) {
+        winfo           = &ThreadGetRunning()->winfo.dataque;
+        winfo->data_ptr = (uint32_t)data_ptr;
+        winfo->count    = 0U;
+      }
     }
     else {
-      /* No memory available */
-      if (timeout != 0U) {
-        /* Suspend current Thread */
-        status = krnThreadWaitEnter(ThreadWaitingQueuePut, &dq->wait_put_queue, timeout);
-        if (status != osErrorTimeout) {
-          ThreadGetRunning()->winfo.dataque.data_ptr = (uint32_t)data_ptr;
-        }
-      }
-      else {
-        status = osErrorResource;
-      }
+      status = osErrorResource;
     }
   }
 
@@ -187,9 +417,9 @@ static osStatus_t svcDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, u
 
 static osStatus_t svcDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeout)
 {
-  osDataQueue_t    *dq = dq_id;
-  osThread_t       *thread;
-  osStatus_t        status;
+  osDataQueue_t   *dq = dq_id;
+  winfo_dataque_t *winfo;
+  osStatus_t       status;
 
   /* Check parameters */
   if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL)) {
@@ -197,16 +427,10 @@ static osStatus_t svcDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_
   }
 
   /* Get Data from Queue */
-  if (DataGet(dq, data_ptr) != false) {
+  if (DataGetN(dq, data_ptr, 1U) != 0U) {
     /* Check if Thread is waiting to send a data */
-    if (!isQueueEmpty(&dq->wait_put_queue)) {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(dq->wait_put_queue.next);
-      /* Try to put a data into Queue */
-      if (DataPut(dq, (const void *)thread->winfo.dataque.data_ptr) != false) {
-        /* Wakeup waiting Thread with highest Priority */
-        krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-      }
+    if (DataWakePut(dq)) {
+      SchedDispatch(NULL);
     }
     status = osOK;
   }
@@ -216,7 +440,9 @@ static osStatus_t svcDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_
       /* Suspend current Thread */
       status = krnThreadWaitEnter(ThreadWaitingQueueGet, &dq->wait_get_queue, timeout);
       if (status != osErrorTimeout) {
-        ThreadGetRunning()->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+        winfo           = &ThreadGetRunning()->winfo.dataque;
+        winfo->data_ptr = (uint32_t)data_ptr;
+        winfo->count    = 0U;
       }
     }
     else {
@@ -227,6 +453,77 @@ static osStatus_t svcDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_
   return (status);
 }
 
+static uint32_t svcDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t   *dq = dq_id;
+  winfo_dataque_t *winfo;
+  uint32_t         num;
+
+  /* Check parameters */
+  if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) || (count == 0U)) {
+    return (0U);
+  }
+
+  /* Pass data to waiting Threads and put the rest into Queue */
+  if (!isQueueEmpty(&dq->wait_get_queue)) {
+    num = DataSend(dq, data_ptr, count);
+    SchedDispatch(NULL);
+  }
+  else {
+    num = DataPutN(dq, data_ptr, count);
+  }
+
+  if ((num == 0U) && (timeout != 0U)) {
+    /* Suspend current Thread */
+    num = (uint32_t)krnThreadWaitEnter(ThreadWaitingQueuePut, &dq->wait_put_queue, timeout);
+    if (num == (uint32_t)osErrorTimeout) {
+      num = 0U;
+    }
+    else {
+      winfo           = &ThreadGetRunning()->winfo.dataque;
+      winfo->data_ptr = (uint32_t)data_ptr;
+      winfo->count    = count;
+    }
+  }
+
+  return (num);
+}
+
+static uint32_t svcDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t   *dq = dq_id;
+  winfo_dataque_t *winfo;
+  uint32_t         num;
+
+  /* Check parameters */
+  if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) || (count == 0U)) {
+    return (0U);
+  }
+
+  /* Get Data from Queue */
+  num = DataGetN(dq, data_ptr, count);
+  if (num != 0U) {
+    /* Check if Threads are waiting to send data */
+    if (DataWakePut(dq)) {
+      SchedDispatch(NULL);
+    }
+  }
+  else if (timeout != 0U) {
+    /* Suspend current Thread */
+    num = (uint32_t)krnThreadWaitEnter(ThreadWaitingQueueGet, &dq->wait_get_queue, timeout);
+    if (num == (uint32_t)osErrorTimeout) {
+      num = 0U;
+    }
+    else {
+      winfo           = &ThreadGetRunning()->winfo.dataque;
+      winfo->data_ptr = (uint32_t)data_ptr;
+      winfo->count    = count;
+    }
+  }
+
+  return (num);
+}
+
 static uint32_t svcDataQueueGetCapacity(osDataQueueId_t dq_id)
 {
   osDataQueue_t *dq = dq_id;
@@ -272,14 +569,12 @@ static uint32_t svcDataQueueGetSpace(osDataQueueId_t dq_id)
     return (0U);
   }
 
-  return (dq->max_data_count - dq->data_count);
+  return (DataSpace(dq));
 }
 
 static osStatus_t svcDataQueueReset(osDataQueueId_t dq_id)
 {
-  osDataQueue_t    *dq = dq_id;
-  osThread_t       *thread;
-  winfo_dataque_t  *winfo;
+  osDataQueue_t *dq = dq_id;
 
   /* Check parameters */
   if ((dq == NULL) || (dq->id != ID_DATA_QUEUE)) {
@@ -289,19 +584,7 @@ static osStatus_t svcDataQueueReset(osDataQueueId_t dq_id)
   /* Remove data from Queue */
   DataReset(dq);
   /* Check if Threads are waiting to send a data */
-  if (!isQueueEmpty(&dq->wait_put_queue)) {
-    do {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(dq->wait_put_queue.next);
-      winfo = &thread->winfo.dataque;
-      /* Try to put a data into Queue */
-      if (DataPut(dq, (const void *)winfo->data_ptr) == false) {
-        break;
-      }
-      /* Wakeup waiting Thread with highest Priority */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    } while(!isQueueEmpty(&dq->wait_put_queue));
-
+  if (DataWakePut(dq)) {
     SchedDispatch(NULL);
   }
 
@@ -344,7 +627,7 @@ osStatus_t isrDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint32_t
   }
 
   /* Try to put a data into Queue */
-  if (DataPut(dq, data_ptr) != false) {
+  if (DataPutN(dq, data_ptr, 1U) != 0U) {
     /* Register post ISR processing */
     krnPostProcess((osObject_t *)dq);
     status = osOK;
@@ -370,7 +653,7 @@ osStatus_t isrDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeo
   }
 
   /* Get Data from Queue */
-  if (DataGet(dq, data_ptr) != false) {
+  if (DataGetN(dq, data_ptr, 1U) != 0U) {
     /* Register post ISR processing */
     krnPostProcess((osObject_t *)dq);
     status = osOK;
@@ -383,6 +666,50 @@ osStatus_t isrDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeo
   return (status);
 }
 
+__STATIC_INLINE
+uint32_t isrDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t *dq = dq_id;
+  uint32_t       num;
+
+  /* Check parameters */
+  if ((dq       == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) ||
+      (count    == 0U)   || (timeout != 0U)) {
+    return (0U);
+  }
+
+  /* Try to put data into Queue */
+  num = DataPutN(dq, data_ptr, count);
+  if (num != 0U) {
+    /* Register post ISR processing */
+    krnPostProcess((osObject_t *)dq);
+  }
+
+  return (num);
+}
+
+__STATIC_INLINE
+uint32_t isrDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t *dq = dq_id;
+  uint32_t       num;
+
+  /* Check parameters */
+  if ((dq       == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) ||
+      (count    == 0U)   || (timeout != 0U)) {
+    return (0U);
+  }
+
+  /* Get Data from Queue */
+  num = DataGetN(dq, data_ptr, count);
+  if (num != 0U) {
+    /* Register post ISR processing */
+    krnPostProcess((osObject_t *)dq);
+  }
+
+  return (num);
+}
+
 /*******************************************************************************
  *  Post ISR processing
  ******************************************************************************/
@@ -393,26 +720,10 @@ osStatus_t isrDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeo
  */
 void krnDataQueuePostProcess(osDataQueue_t *dq)
 {
-  osThread_t *thread;
-
-  /* Check if Thread is waiting to receive a data */
-  if (!isQueueEmpty(&dq->wait_get_queue)) {
-    thread = GetThreadByQueue(dq->wait_get_queue.next);
-    /* Try to get Data from Queue */
-    if (DataGet(dq, (void *)thread->winfo.dataque.data_ptr) != false) {
-      /* Wakeup waiting Thread with highest Priority */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    }
-  }
-  /* Check if Thread is waiting to send a data */
-  else if (!isQueueEmpty(&dq->wait_put_queue)) {
-    /* Get waiting Thread with highest Priority */
-    thread = GetThreadByQueue(dq->wait_put_queue.next);
-    /* Try to put a data into Queue */
-    if (DataPut(dq, (const void *)thread->winfo.dataque.data_ptr) != false) {
-      /* Wakeup waiting Thread with highest Priority */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    }
+  /* Check if Threads are waiting to receive data */
+  if (!DataWakeGet(dq)) {
+    /* Check if Threads are waiting to send data */
+    (void)DataWakePut(dq);
   }
 }
 
@@ -512,6 +823,64 @@ osStatus_t osDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeou
   return (status);
 }
 
+/**
+ * @fn          uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Put up to count Data into a Queue or timeout if Queue is full.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[in]   data_ptr  pointer to buffer with data to put into a queue.
+ * @param[in]   count     number of data in the buffer.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data put into a queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    num = isrDataQueuePutN(dq_id, data_ptr, count, timeout);
+  }
+  else {
+    num = SVC_4(dq_id, data_ptr, count, timeout, svcDataQueuePutN);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+      if ((int32_t)num < 0) {
+        num = 0U;
+      }
+    }
+  }
+
+  return (num);
+}
+
+/**
+ * @fn          uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Get up to count Data from a Queue or timeout if Queue is empty.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[out]  data_ptr  pointer to buffer for data to get from a queue.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data got from a queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    num = isrDataQueueGetN(dq_id, data_ptr, count, timeout);
+  }
+  else {
+    num = SVC_4(dq_id, data_ptr, count, timeout, svcDataQueueGetN);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+      if ((int32_t)num < 0) {
+        num = 0U;
+      }
+    }
+  }
+
+  return (num);
+}
+
 /**
  * @fn          uint32_t osDataQueueGetCapacity(osDataQueueId_t dq_id)
  * @brief       Get maximum number of data in a Data Queue.
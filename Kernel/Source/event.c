@@ -96,22 +96,42 @@ uint32_t EventFlagsCheck(osEventFlags_t *evf, uint32_t flags, uint32_t options)
 static osEventFlagsId_t svcEventFlagsNew(const osEventFlagsAttr_t *attr)
 {
   osEventFlags_t *evf;
+  const char     *name;
+  uint8_t         flags;
 
-  /* Check parameters */
-  if ((attr == NULL)                        ||
-      (attr->cb_mem == NULL)                ||
-      (((uint32_t)attr->cb_mem & 3U) != 0U) ||
-      (attr->cb_size < sizeof(osEventFlags_t)))
-  {
-    return (NULL);
+  if (attr != NULL) {
+    evf  = attr->cb_mem;
+    name = attr->name;
+
+    /* Check parameters */
+    if (evf != NULL) {
+      if ((((uint32_t)evf & 3U) != 0U) || (attr->cb_size < sizeof(osEventFlags_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    evf  = NULL;
+    name = NULL;
   }
 
-  evf = attr->cb_mem;
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (evf == NULL) {
+    evf = krnObjectMemAlloc(osConfig.mpi.event_flags, sizeof(osEventFlags_t));
+    if (evf == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
+  }
 
   /* Initialize control block */
   evf->id = ID_EVENT_FLAGS;
-  evf->flags = 0U;
-  evf->name = attr->name;
+  evf->flags = flags;
+  evf->name = name;
   evf->event_flags = 0U;
 
   QueueReset(&evf->wait_queue);
@@ -247,6 +267,12 @@ static osStatus_t svcEventFlagsDelete(osEventFlagsId_t ef_id)
 
   /* Mark object as invalid */
   evf->id = ID_INVALID;
+  krnPostProcessCancel((osObject_t *)evf);
+
+  /* Free object memory */
+  if ((evf->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.event_flags, evf);
+  }
 
   return (osOK);
 }
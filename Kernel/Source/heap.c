@@ -0,0 +1,745 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Variable-size heap, Two-Level Segregated Fit.
+ *
+ * Free blocks are kept in size classes: the first level is the power of two
+ * of the block size, the second level splits each power of two into
+ * HEAP_SL_COUNT ranges. Two bitmaps mark the non-empty classes, so a block
+ * of suitable size is found with two bit scans and no list walk.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernel_lib.h"
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define HEAP_ALIGN_LOG2           (3U)
+#define HEAP_ALIGN                (1U << HEAP_ALIGN_LOG2)
+#define HEAP_FL_SHIFT             (HEAP_SL_LOG2 + HEAP_ALIGN_LOG2)
+#define HEAP_SMALL_BLOCK          (1U << HEAP_FL_SHIFT)
+
+#define HEAP_BLOCK_HDR            ((uint32_t)offsetof(osHeapBlock_t, next_free))
+#define HEAP_BLOCK_MIN            ((uint32_t)sizeof(osHeapBlock_t) - HEAP_BLOCK_HDR)
+
+#define HEAP_BLOCK_FREE           (1U << 0)
+#define HEAP_BLOCK_PENDING        (1U << 1)
+#define HEAP_BLOCK_FLAGS          (HEAP_ALIGN - 1U)
+
+#define HEAP_BLOCK_SIZE(block)    ((block)->size & ~HEAP_BLOCK_FLAGS)
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+__STATIC_INLINE
+uint32_t HeapFindLastSet(uint32_t value)
+{
+  return (31U - __CLZ(value));
+}
+
+__STATIC_INLINE
+uint32_t HeapFindFirstSet(uint32_t value)
+{
+  return (31U - __CLZ(value & (0U - value)));
+}
+
+__STATIC_INLINE
+osHeapBlock_t *HeapBlockNext(osHeapBlock_t *block)
+{
+  return ((osHeapBlock_t *)((uint8_t *)block + HEAP_BLOCK_HDR + HEAP_BLOCK_SIZE(block)));
+}
+
+__STATIC_INLINE
+osHeapBlock_t *HeapBlockFromPtr(void *ptr)
+{
+  return ((osHeapBlock_t *)((uint8_t *)ptr - HEAP_BLOCK_HDR));
+}
+
+__STATIC_INLINE
+void *HeapBlockToPtr(osHeapBlock_t *block)
+{
+  return ((uint8_t *)block + HEAP_BLOCK_HDR);
+}
+
+/**
+ * @brief       Get the size class of a block size.
+ * @param[in]   size  block size in bytes.
+ * @param[out]  fl    first level index.
+ * @param[out]  sl    second level index.
+ */
+static void HeapMapping(uint32_t size, uint32_t *fl, uint32_t *sl)
+{
+  uint32_t t;
+
+  if (size < HEAP_SMALL_BLOCK) {
+    *fl = 0U;
+    *sl = size >> HEAP_ALIGN_LOG2;
+  }
+  else {
+    t   = HeapFindLastSet(size);
+    *sl = (size >> (t - HEAP_SL_LOG2)) ^ HEAP_SL_COUNT;
+    *fl = t - (HEAP_FL_SHIFT - 1U);
+  }
+}
+
+/**
+ * @brief       Add a block to the free list of its size class.
+ * @param[in]   heap    heap object.
+ * @param[in]   block   free block.
+ */
+static void HeapInsert(osHeap_t *heap, osHeapBlock_t *block)
+{
+  osHeapBlock_t *head;
+  uint32_t       fl;
+  uint32_t       sl;
+
+  HeapMapping(HEAP_BLOCK_SIZE(block), &fl, &sl);
+
+  head = heap->free_list[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  heap->free_list[fl][sl] = block;
+
+  heap->fl_bmp     |= (1UL << fl);
+  heap->sl_bmp[fl] |= (1UL << sl);
+
+  heap->free_size += HEAP_BLOCK_SIZE(block);
+  heap->free_blocks++;
+}
+
+/**
+ * @brief       Remove a block from the free list of its size class.
+ * @param[in]   heap    heap object.
+ * @param[in]   block   free block.
+ */
+static void HeapRemove(osHeap_t *heap, osHeapBlock_t *block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  HeapMapping(HEAP_BLOCK_SIZE(block), &fl, &sl);
+
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  }
+  else {
+    heap->free_list[fl][sl] = block->next_free;
+    if (block->next_free == NULL) {
+      heap->sl_bmp[fl] &= ~(1UL << sl);
+      if (heap->sl_bmp[fl] == 0U) {
+        heap->fl_bmp &= ~(1UL << fl);
+      }
+    }
+  }
+
+  heap->free_size -= HEAP_BLOCK_SIZE(block);
+  heap->free_blocks--;
+}
+
+/**
+ * @brief       Find a free block of at least size bytes.
+ * @param[in]   heap  heap object.
+ * @param[in]   size  block size in bytes.
+ * @return      free block or NULL if there is none.
+ */
+static osHeapBlock_t *HeapFind(osHeap_t *heap, uint32_t size)
+{
+  uint32_t fl;
+  uint32_t sl;
+  uint32_t bmp;
+
+  /* Round up to the next class, so any block of the class found fits */
+  if (size >= HEAP_SMALL_BLOCK) {
+    size += (1UL << (HeapFindLastSet(size) - HEAP_SL_LOG2)) - 1U;
+  }
+  HeapMapping(size, &fl, &sl);
+  if (fl >= HEAP_FL_COUNT) {
+    return (NULL);
+  }
+
+  bmp = heap->sl_bmp[fl] & (~0UL << sl);
+  if (bmp == 0U) {
+    /* Take the smallest class of a higher first level */
+    if (fl == (HEAP_FL_COUNT - 1U)) {
+      return (NULL);
+    }
+    bmp = heap->fl_bmp & (~0UL << (fl + 1U));
+    if (bmp == 0U) {
+      return (NULL);
+    }
+    fl  = HeapFindFirstSet(bmp);
+    bmp = heap->sl_bmp[fl];
+  }
+  sl = HeapFindFirstSet(bmp);
+
+  return (heap->free_list[fl][sl]);
+}
+
+/**
+ * @brief       Allocate a block.
+ * @param[in]   heap  heap object.
+ * @param[in]   size  requested size in bytes.
+ * @return      allocated block or NULL if there is no memory.
+ */
+static osHeapBlock_t *HeapAllocBlock(osHeap_t *heap, uint32_t size)
+{
+  osHeapBlock_t *block;
+  osHeapBlock_t *remain;
+  uint32_t       block_size;
+
+  size = (size + (HEAP_ALIGN - 1U)) & ~(HEAP_ALIGN - 1U);
+  if (size < HEAP_BLOCK_MIN) {
+    size = HEAP_BLOCK_MIN;
+  }
+
+  block = HeapFind(heap, size);
+  if (block == NULL) {
+    return (NULL);
+  }
+  HeapRemove(heap, block);
+
+  /* Return the tail of the block to the heap */
+  block_size = HEAP_BLOCK_SIZE(block);
+  if ((block_size - size) >= (HEAP_BLOCK_HDR + HEAP_BLOCK_MIN)) {
+    block->size = size;
+    remain = HeapBlockNext(block);
+    remain->prev_phys = block;
+    remain->size = (block_size - size - HEAP_BLOCK_HDR) | HEAP_BLOCK_FREE;
+    HeapBlockNext(remain)->prev_phys = remain;
+    HeapInsert(heap, remain);
+  }
+  else {
+    block->size = block_size;
+  }
+
+  heap->used_size += HEAP_BLOCK_SIZE(block);
+  heap->used_blocks++;
+  if (heap->used_size > heap->max_used_size) {
+    heap->max_used_size = heap->used_size;
+  }
+
+  return (block);
+}
+
+/**
+ * @brief       Return a block to the heap, merge it with free neighbours.
+ * @param[in]   heap    heap object.
+ * @param[in]   block   allocated block.
+ */
+static void HeapFreeBlock(osHeap_t *heap, osHeapBlock_t *block)
+{
+  osHeapBlock_t *neighbour;
+
+  heap->used_size -= HEAP_BLOCK_SIZE(block);
+  heap->used_blocks--;
+
+  block->size = HEAP_BLOCK_SIZE(block) | HEAP_BLOCK_FREE;
+
+  neighbour = block->prev_phys;
+  if ((neighbour != NULL) && ((neighbour->size & HEAP_BLOCK_FREE) != 0U)) {
+    HeapRemove(heap, neighbour);
+    neighbour->size += HEAP_BLOCK_HDR + HEAP_BLOCK_SIZE(block);
+    block = neighbour;
+    HeapBlockNext(block)->prev_phys = block;
+  }
+
+  neighbour = HeapBlockNext(block);
+  if ((neighbour->size & HEAP_BLOCK_FREE) != 0U) {
+    HeapRemove(heap, neighbour);
+    block->size += HEAP_BLOCK_HDR + HEAP_BLOCK_SIZE(neighbour);
+    HeapBlockNext(block)->prev_phys = block;
+  }
+
+  HeapInsert(heap, block);
+}
+
+/**
+ * @brief       Check that a pointer is an allocated block of the heap.
+ * @param[in]   heap  heap object.
+ * @param[in]   ptr   address of the memory block.
+ * @return      block or NULL if the pointer is not an allocated block.
+ */
+static osHeapBlock_t *HeapCheck(osHeap_t *heap, void *ptr)
+{
+  osHeapBlock_t *block;
+  osHeapBlock_t *next;
+  uint8_t       *limit;
+
+  limit = &heap->heap_mem[heap->heap_size - HEAP_BLOCK_HDR];
+
+  if (((uint8_t *)ptr < &heap->heap_mem[HEAP_BLOCK_HDR]) || ((uint8_t *)ptr >= limit) ||
+      (((uint32_t)ptr & (HEAP_ALIGN - 1U)) != 0U)) {
+    return (NULL);
+  }
+
+  block = HeapBlockFromPtr(ptr);
+  if ((block->size & (HEAP_BLOCK_FREE | HEAP_BLOCK_PENDING)) != 0U) {
+    return (NULL);
+  }
+
+  next = HeapBlockNext(block);
+  if (((uint8_t *)next > limit) || (next->prev_phys != block)) {
+    return (NULL);
+  }
+
+  return (block);
+}
+
+/**
+ * @brief       Return the blocks freed by ISRs to the heap.
+ * @param[in]   heap  heap object.
+ * @return      true if a block was returned.
+ */
+static bool HeapFreePending(osHeap_t *heap)
+{
+  void *ptr;
+  bool  freed = false;
+
+  for (;;) {
+    BEGIN_CRITICAL_SECTION
+
+    ptr = heap->isr_free;
+    if (ptr != NULL) {
+      heap->isr_free = *((void **)ptr);
+    }
+
+    END_CRITICAL_SECTION
+
+    if (ptr == NULL) {
+      break;
+    }
+    HeapFreeBlock(heap, HeapBlockFromPtr(ptr));
+    freed = true;
+  }
+
+  return (freed);
+}
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Initialize Heap.
+ * @param[in]   heap      heap object.
+ * @param[in]   heap_mem  pointer to memory for heap storage (8 byte aligned).
+ * @param[in]   size      heap size in bytes.
+ * @return      true if the heap was initialized, false if the size does not fit.
+ */
+bool krnHeapInit(osHeap_t *heap, void *heap_mem, uint32_t size)
+{
+  osHeapBlock_t *block;
+  osHeapBlock_t *sentinel;
+
+  /* The whole heap has to fit one size class */
+  size &= ~(HEAP_ALIGN - 1U);
+  if ((size < ((2U * HEAP_BLOCK_HDR) + HEAP_BLOCK_MIN)) || ((size - (2U * HEAP_BLOCK_HDR)) >= (1UL << HEAP_SIZE_LOG2))) {
+    return (false);
+  }
+
+  /* Initialize control block */
+  memset(heap, 0, sizeof(osHeap_t));
+  heap->id        = ID_HEAP;
+  heap->heap_mem  = heap_mem;
+  heap->heap_size = size;
+  QueueReset(&heap->post_queue);
+
+  /* One free block followed by an allocated block of zero size, that stops merging */
+  block    = (osHeapBlock_t *)heap_mem;
+  sentinel = (osHeapBlock_t *)&heap->heap_mem[size - HEAP_BLOCK_HDR];
+
+  block->prev_phys    = NULL;
+  block->size         = (size - (2U * HEAP_BLOCK_HDR)) | HEAP_BLOCK_FREE;
+  sentinel->prev_phys = block;
+  sentinel->size      = 0U;
+  HeapInsert(heap, block);
+
+  return (true);
+}
+
+/**
+ * @brief       Allocate a memory block from a Heap.
+ * @param[in]   heap  heap object.
+ * @param[in]   size  size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *krnHeapAlloc(osHeap_t *heap, uint32_t size)
+{
+  osHeapBlock_t *block;
+
+  if ((size == 0U) || (size > heap->heap_size)) {
+    return (NULL);
+  }
+
+  block = HeapAllocBlock(heap, size);
+  if ((block == NULL) && HeapFreePending(heap)) {
+    /* Blocks freed by ISRs were not returned yet */
+    block = HeapAllocBlock(heap, size);
+  }
+
+  return ((block != NULL) ? HeapBlockToPtr(block) : NULL);
+}
+
+/**
+ * @brief       Return an allocated memory block back to a Heap.
+ * @param[in]   heap  heap object.
+ * @param[in]   ptr   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t krnHeapFree(osHeap_t *heap, void *ptr)
+{
+  osHeapBlock_t *block;
+
+  block = HeapCheck(heap, ptr);
+  if (block == NULL) {
+    return (osErrorParameter);
+  }
+
+  HeapFreeBlock(heap, block);
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  Service Calls
+ ******************************************************************************/
+
+static osHeapId_t svcHeapNew(uint32_t size, const osHeapAttr_t *attr)
+{
+  osHeap_t *heap;
+  uint8_t  *heap_mem;
+
+  /* Check parameters */
+  if (attr == NULL) {
+    return (NULL);
+  }
+
+  heap     = attr->cb_mem;
+  heap_mem = attr->heap_mem;
+
+  /* Check parameters */
+  if ((heap == NULL) || (((uint32_t)heap & 3U) != 0U) || (attr->cb_size < sizeof(osHeap_t)) ||
+      (heap_mem == NULL) || (((uint32_t)heap_mem & (HEAP_ALIGN - 1U)) != 0U) || (attr->heap_size < size)) {
+    return (NULL);
+  }
+
+  if (!krnHeapInit(heap, heap_mem, size)) {
+    return (NULL);
+  }
+  heap->name = attr->name;
+
+  return (heap);
+}
+
+static const char *svcHeapGetName(osHeapId_t heap_id)
+{
+  osHeap_t *heap = heap_id;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP)) {
+    return (NULL);
+  }
+
+  return (heap->name);
+}
+
+static void *svcHeapAlloc(osHeapId_t heap_id, uint32_t size)
+{
+  osHeap_t *heap = heap_id;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP)) {
+    return (NULL);
+  }
+
+  return (krnHeapAlloc(heap, size));
+}
+
+static osStatus_t svcHeapFree(osHeapId_t heap_id, void *ptr)
+{
+  osHeap_t *heap = heap_id;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP)) {
+    return (osErrorParameter);
+  }
+
+  return (krnHeapFree(heap, ptr));
+}
+
+static osStatus_t svcHeapGetStats(osHeapId_t heap_id, osHeapStats_t *stats)
+{
+  osHeap_t      *heap = heap_id;
+  osHeapBlock_t *block;
+  uint32_t       max_free;
+  uint32_t       frag;
+  uint32_t       free_size;
+  uint32_t       fl;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP) || (stats == NULL)) {
+    return (osErrorParameter);
+  }
+
+  /* The largest free block is in the highest non-empty class */
+  max_free = 0U;
+  if (heap->fl_bmp != 0U) {
+    fl = HeapFindLastSet(heap->fl_bmp);
+    block = heap->free_list[fl][HeapFindLastSet(heap->sl_bmp[fl])];
+    while (block != NULL) {
+      if (HEAP_BLOCK_SIZE(block) > max_free) {
+        max_free = HEAP_BLOCK_SIZE(block);
+      }
+      block = block->next_free;
+    }
+  }
+
+  free_size = heap->free_size;
+  frag = free_size - max_free;
+  if (free_size > (0xFFFFFFFFU / 100U)) {
+    free_size >>= 7;
+    frag      >>= 7;
+  }
+
+  stats->total_size     = heap->heap_size;
+  stats->used_size      = heap->used_size;
+  stats->max_used_size  = heap->max_used_size;
+  stats->used_blocks    = heap->used_blocks;
+  stats->free_size      = heap->free_size;
+  stats->free_blocks    = heap->free_blocks;
+  stats->max_free_block = max_free;
+  stats->fragmentation  = (free_size != 0U) ? ((frag * 100U) / free_size) : 0U;
+
+  return (osOK);
+}
+
+static osStatus_t svcHeapDelete(osHeapId_t heap_id)
+{
+  osHeap_t *heap = heap_id;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP)) {
+    return (osErrorParameter);
+  }
+
+  /* Mark object as invalid */
+  heap->id = ID_INVALID;
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  ISR Calls
+ ******************************************************************************/
+
+__STATIC_INLINE
+osStatus_t isrHeapFree(osHeapId_t heap_id, void *ptr)
+{
+  osHeap_t      *heap = heap_id;
+  osHeapBlock_t *block;
+  osStatus_t     status;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->id != ID_HEAP)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  block = HeapCheck(heap, ptr);
+  if (block != NULL) {
+    /* Keep the block until post ISR processing returns it to the heap */
+    block->size |= HEAP_BLOCK_PENDING;
+    *((void **)ptr) = heap->isr_free;
+    heap->isr_free = ptr;
+    status = osOK;
+  }
+  else {
+    status = osErrorParameter;
+  }
+
+  END_CRITICAL_SECTION
+
+  if (status == osOK) {
+    /* Register post ISR processing */
+    krnPostProcess((osObject_t *)heap);
+  }
+
+  return (status);
+}
+
+/*******************************************************************************
+ *  Post ISR processing
+ ******************************************************************************/
+
+/**
+ * @brief       Heap post ISR processing.
+ * @param[in]   heap  heap object.
+ */
+void krnHeapPostProcess(osHeap_t *heap)
+{
+  (void)HeapFreePending(heap);
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          osHeapId_t osHeapNew(uint32_t size, const osHeapAttr_t *attr)
+ * @brief       Create and Initialize a Heap object.
+ * @param[in]   size    heap size in bytes.
+ * @param[in]   attr    heap attributes.
+ * @return      heap ID for reference by other functions or NULL in case of error.
+ */
+osHeapId_t osHeapNew(uint32_t size, const osHeapAttr_t *attr)
+{
+  osHeapId_t heap_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    heap_id = NULL;
+  }
+  else {
+    heap_id = (osHeapId_t)SVC_2(size, attr, svcHeapNew);
+  }
+
+  return (heap_id);
+}
+
+/**
+ * @fn          const char *osHeapGetName(osHeapId_t heap_id)
+ * @brief       Get name of a Heap object.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osHeapGetName(osHeapId_t heap_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)SVC_1(heap_id, svcHeapGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          void *osHeapAlloc(osHeapId_t heap_id, uint32_t size)
+ * @brief       Allocate a memory block from a Heap in constant time.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[in]   size      size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osHeapAlloc(osHeapId_t heap_id, uint32_t size)
+{
+  void *memory;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    memory = NULL;
+  }
+  else {
+    memory = (void *)SVC_2(heap_id, size, svcHeapAlloc);
+  }
+
+  return (memory);
+}
+
+/**
+ * @fn          osStatus_t osHeapFree(osHeapId_t heap_id, void *block)
+ * @brief       Return an allocated memory block back to a Heap in constant time.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[in]   block     address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapFree(osHeapId_t heap_id, void *block)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = isrHeapFree(heap_id, block);
+  }
+  else {
+    status = (osStatus_t)SVC_2(heap_id, block, svcHeapFree);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osHeapGetStats(osHeapId_t heap_id, osHeapStats_t *stats)
+ * @brief       Get usage statistics of a Heap.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @param[out]  stats     pointer to buffer for the statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapGetStats(osHeapId_t heap_id, osHeapStats_t *stats)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_2(heap_id, stats, svcHeapGetStats);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osHeapDelete(osHeapId_t heap_id)
+ * @brief       Delete a Heap object.
+ * @param[in]   heap_id   heap ID obtained by \ref osHeapNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapDelete(osHeapId_t heap_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_1(heap_id, svcHeapDelete);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
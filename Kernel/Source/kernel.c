@@ -47,10 +47,20 @@ static osStatus_t svcKernelInitialize(void)
     QueueReset(&osInfo.ready_list[i]);
   }
 
-  QueueReset(&osInfo.timer_queue);
-  QueueReset(&osInfo.delay_queue);
+  QueueReset(&osInfo.thread_list);
+  QueueReset(&osInfo.thread.exited);
+  QueueReset(&osInfo.budget.exhausted);
+  krnWheelInit(&osInfo.timer, (ptrdiff_t)offsetof(osTimer_t, time) - (ptrdiff_t)offsetof(osTimer_t, timer_que));
+  krnWheelInit(&osInfo.delay, (ptrdiff_t)offsetof(osThread_t, delay) - (ptrdiff_t)offsetof(osThread_t, delay_que));
   QueueReset(&osInfo.post_queue);
 
+  /* Initialize memory for objects without user provided memory */
+  krnObjectMemInit();
+
+#if (OS_TRACE != 0)
+  krnTraceInit();
+#endif
+
   osInfo.kernel.state = osKernelReady;
 
   return (osOK);
@@ -195,6 +205,50 @@ static int32_t svcKernelRestoreLock(int32_t lock)
 #pragma GCC diagnostic pop
 #endif
 
+static uint32_t svcKernelSuspend(void)
+{
+  uint32_t delay;
+  uint32_t ticks;
+
+  if (osInfo.kernel.state != osKernelRunning) {
+    return (0U);
+  }
+
+  /* Check Thread Delays */
+  delay = krnWheelGetNext(&osInfo.delay);
+
+  /* Check Active Timers */
+  ticks = krnWheelGetNext(&osInfo.timer);
+  if (ticks < delay) {
+    delay = ticks;
+  }
+
+  /* Suspend ticks */
+  osTickDisable();
+
+  osInfo.kernel.state = osKernelSuspended;
+
+  return (delay);
+}
+
+static void svcKernelResume(uint32_t sleep_ticks)
+{
+  if (osInfo.kernel.state != osKernelSuspended) {
+    return;
+  }
+
+  /* Process expired Timers and Thread Delays */
+  osInfo.kernel.tick += sleep_ticks;
+  (void)krnTimeoutProcess();
+
+  osInfo.kernel.state = osKernelRunning;
+
+  /* Resume ticks */
+  osTickEnable();
+
+  SchedDispatch(NULL);
+}
+
 static uint32_t svcKernelGetTickCount(void)
 {
   return (osInfo.kernel.tick);
@@ -207,18 +261,7 @@ static uint32_t svcKernelGetTickFreq(void)
 
 static uint32_t svcKernelGetSysTimerCount(void)
 {
-  uint32_t tick;
-  uint32_t count;
-
-  tick  = osInfo.kernel.tick;
-  count = osTickGetCount();
-  if (osTickGetOverflow() != 0U) {
-    count = osTickGetCount();
-    tick++;
-  }
-  count += tick * osTickGetInterval();
-
-  return (count);
+  return (krnSysTimerGetCount());
 }
 
 static uint32_t svcKernelGetSysTimerFreq(void)
@@ -228,6 +271,15 @@ static uint32_t svcKernelGetSysTimerFreq(void)
   return (freq);
 }
 
+static uint32_t svcKernelGetCpuLoad(void)
+{
+  if (((osConfig.flags & osConfigCpuUsage) == 0U) || (osInfo.thread.idle == NULL)) {
+    return (0U);
+  }
+
+  return (100U - krnThreadGetCpuUsage(osInfo.thread.idle));
+}
+
 /*******************************************************************************
  *  function implementations (scope: module-exported)
  ******************************************************************************/
@@ -369,6 +421,39 @@ int32_t osKernelRestoreLock(int32_t lock)
   return (lock_new);
 }
 
+/**
+ * @fn          uint32_t osKernelSuspend(void)
+ * @brief       Suspend the RTOS Kernel scheduler.
+ * @return      time in ticks, for how long the system can sleep or power-down.
+ */
+uint32_t osKernelSuspend(void)
+{
+  uint32_t ticks;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    ticks = 0U;
+  }
+  else {
+    ticks = SVC_0(svcKernelSuspend);
+  }
+
+  return (ticks);
+}
+
+/**
+ * @fn          void osKernelResume(uint32_t sleep_ticks)
+ * @brief       Resume the RTOS Kernel scheduler.
+ * @param[in]   sleep_ticks   time in ticks for how long the system was in sleep or power-down mode.
+ */
+void osKernelResume(uint32_t sleep_ticks)
+{
+  if (IsIrqMode() || IsIrqMasked()) {
+    return;
+  }
+
+  SVC_1(sleep_ticks, svcKernelResume);
+}
+
 /**
  * @fn          uint32_t osKernelGetTickCount(void)
  * @brief       Get the RTOS kernel tick count.
@@ -442,3 +527,40 @@ uint32_t osKernelGetSysTimerFreq(void)
 
   return (freq);
 }
+
+/**
+ * @fn          uint32_t osKernelGetCpuLoad(void)
+ * @brief       Get the CPU load over the last second, estimated from the
+ *              current and the previous one-second window.
+ * @return      CPU load in percent (time not spent in the Idle Thread).
+ */
+uint32_t osKernelGetCpuLoad(void)
+{
+  uint32_t load;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    load = 0U;
+  }
+  else {
+    load = SVC_0(svcKernelGetCpuLoad);
+  }
+
+  return (load);
+}
+
+/**
+ * @fn          uint32_t osKernelErrorNotify(uint32_t code, void *object_id)
+ * @brief       Kernel error callback, the default one stops the system.
+ * @param[in]   code        error code (osKernelError...).
+ * @param[in]   object_id   object that caused the error.
+ * @return      0 - the kernel continues.
+ */
+__WEAK
+uint32_t osKernelErrorNotify(uint32_t code, void *object_id)
+{
+  (void) code;
+  (void) object_id;
+
+  for (;;) {
+  }
+}
@@ -24,6 +24,7 @@
 
 #include "arch.h"
 #include "Kernel/kernel.h"
+#include "Kernel/trace.h"
 
 /*******************************************************************************
  *  defines and macros
@@ -40,15 +41,22 @@
 #define ID_SEMAPHORE                (uint8_t)0x6F
 #define ID_EVENT_FLAGS              (uint8_t)0x5E
 #define ID_MEMORYPOOL               (uint8_t)0x26
+#define ID_MEMORY_SLAB              (uint8_t)0x27
 #define ID_MUTEX                    (uint8_t)0x17
 #define ID_TIMER                    (uint8_t)0x7A
 #define ID_MESSAGE_QUEUE            (uint8_t)0x1C
 #define ID_MESSAGE                  (uint8_t)0x1D
 #define ID_DATA_QUEUE               (uint8_t)0x1E
+#define ID_RING_BUFFER              (uint8_t)0x1F
+#define ID_STREAM                   (uint8_t)0x2C
+#define ID_HEAP                     (uint8_t)0x2D
 
 /* Object Flags definitions */
 #define FLAGS_POST_PROC             (uint8_t)(1U << 0U)
 #define FLAGS_TIMER_PROC            (uint8_t)(1U << 1U)
+#define FLAGS_BUDGET_EXHAUSTED      (uint8_t)(1U << 2U)
+#define FLAGS_OBJECT_MEM            (uint8_t)(1U << 6U)   ///< Control block allocated by the kernel
+#define FLAGS_DATA_MEM              (uint8_t)(1U << 7U)   ///< Stack or data storage allocated by the kernel
 
 /* Thread State definitions */
 #define ThreadStateMask             (0x0FU)
@@ -72,18 +80,74 @@
 
 #define GetThreadByQueue(que)       container_of(que, osThread_t, thread_que)
 #define GetThreadByDelayQueue(que)  container_of(que, osThread_t, delay_que)
+#define GetThreadByListQueue(que)   container_of(que, osThread_t, list_que)
+#define GetThreadByBudgetQueue(que) container_of(que, osThread_t, budget_que)
 #define GetThreadByObject(obj)      container_of(obj, osThread_t, id)
 #define GetMutexByQueque(que)       container_of(que, osMutex_t, mutex_que)
 #define GetTimerByQueue(que)        container_of(que, osTimer_t, timer_que)
 #define GetMessageByQueue(que)      container_of(que, osMessage_t, msg_que)
+#define GetSlabPageByQueue(que)     container_of(que, osMemorySlabPage_t, page_que)
 #define GetObjectByQueue(que)       container_of(que, osObject_t, post_queue)
 
 #define osThreadWait                (-16)
 
+/* Timer wheel: TIMER_WHEEL_LEVELS levels of 32 slots each */
+#ifndef TIMER_WHEEL_LEVELS
+#define TIMER_WHEEL_LEVELS          (4U)
+#endif
+#if ((TIMER_WHEEL_LEVELS < 2U) || (TIMER_WHEEL_LEVELS > 6U))
+#error "TIMER_WHEEL_LEVELS must be in range 2..6"
+#endif
+#define TIMER_WHEEL_BITS            (5U)
+#define TIMER_WHEEL_SIZE            (1UL << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK            (TIMER_WHEEL_SIZE - 1U)
+
+/* Priority inheritance: maximum length of the chain of blocked mutex owners */
+#ifndef MUTEX_INHERIT_DEPTH
+#define MUTEX_INHERIT_DEPTH         (8U)
+#endif
+#if (MUTEX_INHERIT_DEPTH < 1U)
+#error "MUTEX_INHERIT_DEPTH must be at least 1"
+#endif
+
+/* Ready bitmap: one bit per priority level, 32 levels per word */
+#define READY_BMP_SIZE              (NUM_PRIORITY / 32U)
+
+/* Event trace: OS_TRACE enables recording into OS_TRACE_SIZE records */
+#ifndef OS_TRACE
+#define OS_TRACE                    0
+#endif
+#ifndef OS_TRACE_SIZE
+#define OS_TRACE_SIZE               (256U)
+#endif
+#if ((OS_TRACE_SIZE & (OS_TRACE_SIZE - 1U)) != 0U)
+#error "OS_TRACE_SIZE must be a power of 2"
+#endif
+
+#if (OS_TRACE != 0)
+#define TRACE_EVENT(event, object, arg)                                        \
+  krnTraceEvent((event), (uint32_t)(object), (uint32_t)(arg))
+#define TRACE_SERVICE(func, param, call)                                       \
+  (krnTraceEvent(osTraceServiceEnter, (uint32_t)(func), (uint32_t)(param)),    \
+   krnTraceServiceExit((uint32_t)(func), (call)))
+#else
+#define TRACE_EVENT(event, object, arg)
+#define TRACE_SERVICE(func, param, call)  (call)
+#endif
+
 /*******************************************************************************
  *  typedefs and structures
  ******************************************************************************/
 
+/* Timer wheel: queues of entries with the event time at a fixed offset */
+typedef struct TimerWheel_s {
+  uint32_t                                tick;   ///< Next tick to be processed
+  ptrdiff_t                             offset;   ///< Offset of the event time from the queue entry
+  uint32_t                bmp[TIMER_WHEEL_LEVELS];   ///< Non-empty slots of each level
+  queue_t                              expired;   ///< Expired entries
+  queue_t   wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SIZE];
+} TimerWheel_t;
+
 /* Kernel Runtime Information structure */
 typedef struct KernelInfo_s {
   struct {
@@ -93,15 +157,30 @@ typedef struct KernelInfo_s {
     } run;
     osThreadId_t                          idle;
     osThreadId_t                         timer;
+    queue_t                             exited;   ///< Threads deleted while running, memory not yet freed
   } thread;
   struct {
     osKernelState_t                      state;   ///< State
     uint32_t                              tick;
   } kernel;
-  uint32_t                    ready_to_run_bmp;
+  struct {
+#if (NUM_PRIORITY > 32U)
+    uint32_t                             group;   ///< Non-empty words of map
+#endif
+    uint32_t                map[READY_BMP_SIZE];   ///< Non-empty ready lists
+  } ready_bmp;
   queue_t             ready_list[NUM_PRIORITY];   ///< all ready to run(RUNNABLE) tasks
-  queue_t                          timer_queue;
-  queue_t                          delay_queue;
+  queue_t                          thread_list;   ///< All created threads
+  uint32_t                        thread_count;   ///< Number of created threads
+  struct {
+    uint32_t                             stamp;   ///< System timer count of the last CPU time update
+  } cpu;
+  struct {
+    uint32_t                             stamp;   ///< System timer count of the last budget update
+    queue_t                          exhausted;   ///< Threads with an exhausted budget
+  } budget;
+  TimerWheel_t                           timer;   ///< Active timers
+  TimerWheel_t                           delay;   ///< Thread delays
   queue_t                           post_queue;   ///< ISR Post Processing queue
 } KernelInfo_t;
 
@@ -158,12 +237,92 @@ osStatus_t krnThreadWaitEnter(uint8_t state, queue_t *wait_que, uint32_t timeout
  */
 void krnThreadWaitDelete(queue_t *que);
 
+/**
+ * @brief       Insert a waiting thread into a wait queue ordered by priority.
+ * @param[in]   wait_que  wait queue.
+ * @param[in]   thread    thread object.
+ */
+void krnThreadWaitQueueInsert(queue_t *wait_que, osThread_t *thread);
+
 /**
  * @brief       Change priority of a thread.
  * @param[in]   thread    thread object.
  * @param[in]   priority  new priority value for the thread.
  */
-void krnThreadSetPriority(osThread_t *thread, int8_t priority);
+void krnThreadSetPriority(osThread_t *thread, int16_t priority);
+
+/**
+ * @brief       Charge the CPU time elapsed since the last update to the running thread.
+ */
+void krnThreadCpuTimeUpdate(void);
+
+/**
+ * @brief       Free the memory of threads that deleted themselves while running.
+ * @note        Must not be called on the stack of such a thread.
+ */
+void krnThreadFreeExited(void);
+
+/**
+ * @brief       Check the stack of a thread whose context was just saved and
+ *              report an overrun by \ref osKernelErrorNotify.
+ * @param[in]   thread  thread object.
+ * @return      true - stack is intact, false - stack overrun.
+ */
+bool krnThreadStackCheck(const osThread_t *thread);
+
+/**
+ * @brief       Charge the running thread for its CPU budget and start
+ *              accounting for the next thread.
+ * @param[in]   thread  thread to be run.
+ */
+void krnThreadBudgetSwitch(osThread_t *thread);
+
+/**
+ * @brief       Charge the running thread for its CPU budget, lower the priority
+ *              of the thread when the budget is used up and replenish budgets.
+ * @return      true - a priority was changed, false - otherwise.
+ */
+bool krnThreadBudgetProcess(void);
+
+/**
+ * @brief       Get the priority of a thread without inheritance.
+ * @param[in]   thread  thread object.
+ * @return      base priority or BUDGET_PRIORITY if the budget is used up.
+ */
+__STATIC_FORCEINLINE
+int16_t ThreadBasePriority(osThread_t *thread)
+{
+  if ((thread->flags & FLAGS_BUDGET_EXHAUSTED) != 0U) {
+    return ((int16_t)BUDGET_PRIORITY);
+  }
+
+  return (thread->base_priority);
+}
+
+/**
+ * @brief       Check a thread or mutex ceiling priority.
+ * @param[in]   priority  priority value.
+ * @return      true - osPriorityIdle or above BUDGET_PRIORITY, false - otherwise.
+ */
+__STATIC_FORCEINLINE
+bool IsPriorityValid(osPriority_t priority)
+{
+  return ((priority == osPriorityIdle) ||
+          ((priority > (osPriority_t)BUDGET_PRIORITY) && (priority <= osPriorityISR)));
+}
+
+/**
+ * @brief       Get CPU usage of a thread over the last second.
+ * @param[in]   thread    thread object.
+ * @return      CPU usage in percent.
+ */
+uint32_t krnThreadGetCpuUsage(osThread_t *thread);
+
+/**
+ * @brief       Get the highest priority of the ready threads.
+ * @return      priority or osPriorityNone if there are no ready threads.
+ */
+int32_t SchedReadyPriorityGet(void);
 
 /**
  * @brief       Dispatch specified Thread or Ready Thread with Highest Priority.
@@ -179,7 +338,8 @@ void SchedDispatch(osThread_t *thread);
 void SchedYield(osThread_t *thread);
 
 /**
- * @brief       Adds thread to the end of ready queue for current priority
+ * @brief       Adds thread to the end of ready queue for current priority,
+ *              threads with a deadline are added in deadline order
  * @param[in]   thread  Thread object
  */
 void SchedThreadReadyAdd(osThread_t *thread);
@@ -260,6 +420,24 @@ void QueueRemoveEntry(queue_t *entry)
   }
 }
 
+/**
+ * @fn          void QueueMove(queue_t *que, queue_t *src)
+ * @brief       Moves all entries of the source queue to the tail of the queue.
+ * @param[out]  que   Pointer to the queue
+ * @param[out]  src   Pointer to the source queue
+ */
+__STATIC_FORCEINLINE
+void QueueMove(queue_t *que, queue_t *src)
+{
+  if (!isQueueEmpty(src)) {
+    src->next->prev = que->prev;
+    src->prev->next = que;
+    que->prev->next = src->next;
+    que->prev = src->prev;
+    QueueReset(src);
+  }
+}
+
 
 /* Timer */
 
@@ -267,12 +445,62 @@ void krnTimerInsert(osTimer_t *timer, uint32_t time);
 void krnTimerRemove(osTimer_t *timer);
 void krnTimerThread(void *argument);
 
+/**
+ * @brief       Initialize the timer wheel.
+ * @param[out]  wheel   timer wheel.
+ * @param[in]   offset  offset of the event time from the queue entry.
+ */
+void krnWheelInit(TimerWheel_t *wheel, ptrdiff_t offset);
+
+/**
+ * @brief       Insert the entry into the timer wheel at its event time.
+ * @param[out]  wheel   timer wheel.
+ * @param[out]  que     wheel entry.
+ */
+void krnWheelInsert(TimerWheel_t *wheel, queue_t *que);
+
+/**
+ * @brief       Remove the entry from the timer wheel or the expired list.
+ * @param[out]  wheel   timer wheel.
+ * @param[out]  que     wheel entry.
+ */
+void krnWheelRemove(TimerWheel_t *wheel, queue_t *que);
+
+/**
+ * @brief       Advance the timer wheel to the current kernel tick.
+ * @param[out]  wheel   timer wheel.
+ * @return      true - there are expired entries, false - otherwise.
+ */
+bool krnWheelProcess(TimerWheel_t *wheel);
+
+/**
+ * @brief       Get number of ticks until the earliest event of the timer wheel.
+ * @param[in]   wheel   timer wheel.
+ * @return      number of ticks or osWaitForever if the wheel is empty.
+ */
+uint32_t krnWheelGetNext(TimerWheel_t *wheel);
+
 /**
  * @brief       Release Mutexes when owner Task terminates.
  * @param[in]   que   Queue of mutexes
  */
 void krnMutexOwnerRelease(queue_t *que);
 
+/**
+ * @brief       Set the priority of a thread to its base priority or to the
+ *              highest priority of the threads waiting for its mutexes, and
+ *              pass the change on along the chain of mutexes it waits for.
+ * @param[in]   thread  thread object.
+ */
+void krnMutexOwnerPriorityRestore(osThread_t *thread);
+
+/**
+ * @brief       Update the owner of the mutex a thread no longer waits for
+ *              (timeout, abort or termination).
+ * @param[in]   thread  thread object removed from the mutex wait queue.
+ */
+void krnMutexWaitAbort(osThread_t *thread);
+
 /**
  * @brief       Initialize Memory Pool.
  * @param[in]   block_count   maximum number of memory blocks in memory pool.
@@ -303,6 +531,52 @@ void *krnMemoryPoolAlloc(osMemoryPoolInfo_t *mp_info);
  */
 osStatus_t krnMemoryPoolFree(osMemoryPoolInfo_t *mp_info, void *block);
 
+/**
+ * @brief       Initialize Heap.
+ * @param[in]   heap      heap object.
+ * @param[in]   heap_mem  pointer to memory for heap storage (8 byte aligned).
+ * @param[in]   size      heap size in bytes.
+ * @return      true if the heap was initialized, false if the size does not fit.
+ */
+bool krnHeapInit(osHeap_t *heap, void *heap_mem, uint32_t size);
+
+/**
+ * @brief       Allocate a memory block from a Heap.
+ * @param[in]   heap  heap object.
+ * @param[in]   size  size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *krnHeapAlloc(osHeap_t *heap, uint32_t size);
+
+/**
+ * @brief       Return an allocated memory block back to a Heap.
+ * @param[in]   heap  heap object.
+ * @param[in]   ptr   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t krnHeapFree(osHeap_t *heap, void *ptr);
+
+/**
+ * @brief       Initialize the object memory pools and heap of the kernel configuration.
+ */
+void krnObjectMemInit(void);
+
+/**
+ * @brief       Allocate memory for an object, from its type's pool or else from
+ *              the object memory heap.
+ * @param[in]   mp_info   pool of the object type or NULL.
+ * @param[in]   size      size in bytes.
+ * @return      address of the memory or NULL in case of no memory is available.
+ */
+void *krnObjectMemAlloc(osMemoryPoolInfo_t *mp_info, uint32_t size);
+
+/**
+ * @brief       Return memory allocated by \ref krnObjectMemAlloc.
+ * @param[in]   mp_info   pool of the object type or NULL.
+ * @param[in]   mem       address of the memory.
+ */
+void krnObjectMemFree(osMemoryPoolInfo_t *mp_info, void *mem);
+
 /*******************************************************************************
  *  Post ISR processing functions
  ******************************************************************************/
@@ -337,12 +611,30 @@ void krnMessageQueuePostProcess(osMessageQueue_t *mq);
  */
 void krnDataQueuePostProcess(osDataQueue_t *dq);
 
+/**
+ * @brief       Ring Buffer post ISR processing.
+ * @param[in]   rb  ring buffer object.
+ */
+void krnRingBufferPostProcess(osRingBuffer_t *rb);
+
+/**
+ * @brief       Stream Buffer post ISR processing.
+ * @param[in]   sb  stream buffer object.
+ */
+void krnStreamPostProcess(osStream_t *sb);
+
 /**
  * @brief       Memory Pool post ISR processing.
  * @param[in]   mp  memory pool object.
  */
 void krnMemoryPoolPostProcess(osMemoryPool_t *mp);
 
+/**
+ * @brief       Heap post ISR processing.
+ * @param[in]   heap  heap object.
+ */
+void krnHeapPostProcess(osHeap_t *heap);
+
 /*******************************************************************************
  *  System Library functions
  ******************************************************************************/
@@ -350,5 +642,14 @@ void krnMemoryPoolPostProcess(osMemoryPool_t *mp);
 extern void osTick_Handler(void);
 extern void osPendSV_Handler(void);
 extern void krnPostProcess(osObject_t *object);
+extern void krnPostProcessCancel(osObject_t *object);
+extern bool krnTimeoutProcess(void);
+extern uint32_t krnSysTimerGetCount(void);
+
+#if (OS_TRACE != 0)
+extern void krnTraceInit(void);
+extern void krnTraceEvent(uint32_t event, uint32_t object, uint32_t arg);
+extern uint32_t krnTraceServiceExit(uint32_t func, uint32_t ret_val);
+#endif
 
 #endif /* _KERNEL_LIB_H_ */
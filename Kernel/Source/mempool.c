@@ -158,26 +158,68 @@ static osMemoryPoolId_t svcMemoryPoolNew(uint32_t block_count, uint32_t block_si
   osMemoryPool_t *mp;
   void           *mp_mem;
   uint32_t        mp_size;
+  const char     *name;
+  uint8_t         flags;
 
   /* Check parameters */
-  if ((block_count == 0U) || (block_size  == 0U) || ((__CLZ(block_count) + __CLZ(block_size)) < 32U) || (attr == NULL)) {
+  if ((block_count == 0U) || (block_size  == 0U) || ((__CLZ(block_count) + __CLZ(block_size)) < 32U)) {
     return (NULL);
   }
 
-  mp      = attr->cb_mem;
-  mp_mem  = attr->mp_mem;
-  mp_size = attr->mp_size;
+  if (attr != NULL) {
+    mp      = attr->cb_mem;
+    mp_mem  = attr->mp_mem;
+    mp_size = attr->mp_size;
+    name    = attr->name;
 
-  /* Check parameters */
-  if ((mp == NULL) || (((uint32_t)mp & 3U) != 0U) || (attr->cb_size < sizeof(osMemoryPool_t)) ||
-      (mp_mem == NULL) || (((uint32_t)mp_mem & 3U) != 0U) || (mp_size < (block_count * block_size))) {
-    return (NULL);
+    /* Check parameters */
+    if (mp != NULL) {
+      if ((((uint32_t)mp & 3U) != 0U) || (attr->cb_size < sizeof(osMemoryPool_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+    if (mp_mem != NULL) {
+      if ((((uint32_t)mp_mem & 3U) != 0U) || (mp_size < (block_count * block_size))) {
+        return (NULL);
+      }
+    }
+    else if (mp_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    mp     = NULL;
+    mp_mem = NULL;
+    name   = NULL;
+  }
+
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (mp == NULL) {
+    mp = krnObjectMemAlloc(osConfig.mpi.memory_pool, sizeof(osMemoryPool_t));
+    if (mp == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
+  }
+  if (mp_mem == NULL) {
+    mp_mem = krnObjectMemAlloc(NULL, block_count * block_size);
+    if (mp_mem == NULL) {
+      if ((flags & FLAGS_OBJECT_MEM) != 0U) {
+        krnObjectMemFree(osConfig.mpi.memory_pool, mp);
+      }
+      return (NULL);
+    }
+    flags |= FLAGS_DATA_MEM;
   }
 
   /* Initialize control block */
   mp->id = ID_MEMORYPOOL;
-  mp->flags = 0U;
-  mp->name = attr->name;
+  mp->flags = flags;
+  mp->name = name;
   QueueReset(&mp->wait_queue);
   QueueReset(&mp->post_queue);
   krnMemoryPoolInit(block_count, block_size, mp_mem, &mp->info);
@@ -305,6 +347,15 @@ static osStatus_t svcMemoryPoolDelete(osMemoryPoolId_t mp_id)
 
   /* Mark object as invalid */
   mp->id = ID_INVALID;
+  krnPostProcessCancel((osObject_t *)mp);
+
+  /* Free data and object memory */
+  if ((mp->flags & FLAGS_DATA_MEM) != 0U) {
+    krnObjectMemFree(NULL, mp->info.block_base);
+  }
+  if ((mp->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.memory_pool, mp);
+  }
 
   return (osOK);
 }
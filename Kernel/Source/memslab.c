@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Memory slab with power of two size classes.
+ *
+ * The memory region is cut into Pages of equal size. A size class takes a
+ * free Page when it runs out of blocks and turns it into a Memory Pool of
+ * its block size. When the last block of a Page is freed the Page returns to
+ * the free Pages and can be taken by any other class.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernel_lib.h"
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define SLAB_PAGE_FREE            (0xFFFFFFFFU)
+#define SLAB_PAGE_BLOCKS_LOG2     (5U)
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+__STATIC_INLINE
+uint32_t SlabLog2Ceil(uint32_t value)
+{
+  return ((value <= 1U) ? 0U : (32U - __CLZ(value - 1U)));
+}
+
+__STATIC_INLINE
+uint8_t *SlabPageMem(osMemorySlab_t *ms, osMemorySlabPage_t *page)
+{
+  return (&ms->page_mem[(uint32_t)(page - ms->page) << ms->page_log2]);
+}
+
+/**
+ * @brief       Allocate a block from the partially used Pages of a size class.
+ * @param[in]   cls   size class.
+ * @return      address of the allocated memory block or NULL if the class has no free blocks.
+ * @note        Must be called with interrupts disabled.
+ */
+static void *SlabClassAlloc(osMemorySlabClass_t *cls)
+{
+  osMemorySlabPage_t *page;
+  void               *block;
+
+  if (isQueueEmpty(&cls->partial)) {
+    return (NULL);
+  }
+
+  page  = GetSlabPageByQueue(cls->partial.next);
+  block = krnMemoryPoolAlloc(&page->info);
+  if (page->info.used_blocks == page->info.max_blocks) {
+    /* Full Pages are not kept in any list */
+    QueueRemoveEntry(&page->page_que);
+  }
+  cls->used_blocks++;
+  if (cls->used_blocks > cls->max_used_blocks) {
+    cls->max_used_blocks = cls->used_blocks;
+  }
+
+  return (block);
+}
+
+/**
+ * @brief       Give a carved Page to its size class and allocate a block.
+ * @param[in]   cls         size class.
+ * @param[in]   page        page initialized for the size class.
+ * @param[in]   size_class  size class index.
+ * @return      address of the allocated memory block.
+ */
+static void *SlabPagePublish(osMemorySlabClass_t *cls, osMemorySlabPage_t *page, uint32_t size_class)
+{
+  void *block;
+
+  BEGIN_CRITICAL_SECTION
+
+  page->size_class = size_class;
+  QueueAppend(&cls->partial, &page->page_que);
+  cls->page_count++;
+  block = SlabClassAlloc(cls);
+
+  END_CRITICAL_SECTION
+
+  return (block);
+}
+
+/**
+ * @brief       Allocate a block of a size class.
+ * @param[in]   ms          memory slab object.
+ * @param[in]   size_class  size class.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+static void *SlabAlloc(osMemorySlab_t *ms, uint32_t size_class)
+{
+  osMemorySlabClass_t *cls = &ms->classes[size_class];
+  osMemorySlabPage_t  *page = NULL;
+  uint32_t             block_log2;
+  void                *block;
+
+  BEGIN_CRITICAL_SECTION
+
+  block = SlabClassAlloc(cls);
+  if ((block == NULL) && !isQueueEmpty(&ms->free_page)) {
+    /* The class ran dry, take over a free Page */
+    page = GetSlabPageByQueue(QueueExtract(&ms->free_page));
+    ms->page_free--;
+  }
+
+  END_CRITICAL_SECTION
+
+  if (page != NULL) {
+    /* The Page is in no list and stays free for SlabFree until it is
+       published, so it is carved with interrupts enabled */
+    block_log2 = ms->min_log2 + size_class;
+    krnMemoryPoolInit(1UL << (ms->page_log2 - block_log2), 1UL << block_log2, SlabPageMem(ms, page), &page->info);
+    block = SlabPagePublish(cls, page, size_class);
+  }
+
+  return (block);
+}
+
+/**
+ * @brief       Return a block to its Page.
+ * @param[in]   ms      memory slab object.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t SlabFree(osMemorySlab_t *ms, void *block)
+{
+  osMemorySlabClass_t *cls;
+  osMemorySlabPage_t  *page;
+  uint32_t             offset;
+  osStatus_t           status;
+
+  if (((uint8_t *)block < ms->page_mem) ||
+      ((uint8_t *)block >= &ms->page_mem[ms->page_count << ms->page_log2])) {
+    return (osErrorParameter);
+  }
+
+  offset = (uint32_t)((uint8_t *)block - ms->page_mem);
+  page   = &ms->page[offset >> ms->page_log2];
+
+  BEGIN_CRITICAL_SECTION
+
+  if ((page->size_class == SLAB_PAGE_FREE) || ((offset & (page->info.block_size - 1U)) != 0U) ||
+      (page->info.used_blocks == 0U)) {
+    status = osErrorParameter;
+  }
+  else {
+    cls = &ms->classes[page->size_class];
+    if (page->info.used_blocks == page->info.max_blocks) {
+      /* The Page was full and gets a free block */
+      QueueAppend(&cls->partial, &page->page_que);
+    }
+    status = krnMemoryPoolFree(&page->info, block);
+    cls->used_blocks--;
+    if (page->info.used_blocks == 0U) {
+      /* Give the empty Page to any class that runs dry */
+      QueueRemoveEntry(&page->page_que);
+      page->size_class = SLAB_PAGE_FREE;
+      QueueAppend(&ms->free_page, &page->page_que);
+      ms->page_free++;
+      cls->page_count--;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+/**
+ * @brief       Get the size class of a block size.
+ * @param[in]   ms    memory slab object.
+ * @param[in]   size  block size in bytes.
+ * @return      size class or class_count if size exceeds the largest class.
+ */
+__STATIC_INLINE
+uint32_t SlabSizeClass(osMemorySlab_t *ms, uint32_t size)
+{
+  uint32_t log2 = SlabLog2Ceil(size);
+
+  if (log2 < ms->min_log2) {
+    return (0U);
+  }
+
+  log2 -= ms->min_log2;
+
+  return ((log2 < ms->class_count) ? log2 : ms->class_count);
+}
+
+/*******************************************************************************
+ *  Service Calls
+ ******************************************************************************/
+
+static osMemorySlabId_t svcMemorySlabNew(uint32_t min_size, uint32_t max_size, const osMemorySlabAttr_t *attr)
+{
+  osMemorySlab_t *ms;
+  uint8_t        *ms_mem;
+  uint32_t        min_log2;
+  uint32_t        max_log2;
+  uint32_t        page_log2;
+  uint32_t        page_count;
+
+  /* Check parameters */
+  if ((min_size == 0U) || (max_size < min_size) || (max_size > 0x80000000U) || (attr == NULL)) {
+    return (NULL);
+  }
+
+  ms     = attr->cb_mem;
+  ms_mem = attr->ms_mem;
+
+  /* Check parameters */
+  if ((ms == NULL) || (((uint32_t)ms & 3U) != 0U) || (attr->cb_size < sizeof(osMemorySlab_t)) ||
+      (ms_mem == NULL) || (((uint32_t)ms_mem & 3U) != 0U)) {
+    return (NULL);
+  }
+
+  /* Free blocks have to hold the free list link */
+  if (min_size < sizeof(void *)) {
+    min_size = sizeof(void *);
+  }
+  min_log2 = SlabLog2Ceil(min_size);
+  max_log2 = SlabLog2Ceil(max_size);
+  if ((max_log2 - min_log2) >= MEM_SLAB_CLASSES) {
+    return (NULL);
+  }
+
+  /* A Page holds the largest block and at least 32 of the smallest */
+  page_log2 = min_log2 + SLAB_PAGE_BLOCKS_LOG2;
+  if (page_log2 < max_log2) {
+    page_log2 = max_log2;
+  }
+  if (page_log2 > 31U) {
+    return (NULL);
+  }
+
+  /* Page descriptors first, then the Pages on an 8 byte boundary */
+  if (attr->ms_size < 8U) {
+    return (NULL);
+  }
+  page_count = (attr->ms_size - 8U) / ((1UL << page_log2) + sizeof(osMemorySlabPage_t));
+  if (page_count == 0U) {
+    return (NULL);
+  }
+
+  /* Initialize control block */
+  memset(ms, 0, sizeof(osMemorySlab_t));
+  ms->id          = ID_MEMORY_SLAB;
+  ms->name        = attr->name;
+  ms->page        = (osMemorySlabPage_t *)ms_mem;
+  ms->page_mem    = (uint8_t *)(((uint32_t)&ms->page[page_count] + 7U) & ~7U);
+  ms->page_count  = page_count;
+  ms->page_free   = page_count;
+  ms->page_log2   = (uint8_t)page_log2;
+  ms->min_log2    = (uint8_t)min_log2;
+  ms->class_count = (uint8_t)(max_log2 - min_log2 + 1U);
+  QueueReset(&ms->post_queue);
+  QueueReset(&ms->free_page);
+
+  for (uint32_t i = 0U; i < ms->class_count; i++) {
+    QueueReset(&ms->classes[i].partial);
+  }
+
+  for (uint32_t i = 0U; i < page_count; i++) {
+    ms->page[i].size_class = SLAB_PAGE_FREE;
+    QueueAppend(&ms->free_page, &ms->page[i].page_que);
+  }
+
+  return (ms);
+}
+
+static const char *svcMemorySlabGetName(osMemorySlabId_t ms_id)
+{
+  osMemorySlab_t *ms = ms_id;
+
+  /* Check parameters */
+  if ((ms == NULL) || (ms->id != ID_MEMORY_SLAB)) {
+    return (NULL);
+  }
+
+  return (ms->name);
+}
+
+static void *svcMemorySlabAlloc(osMemorySlabId_t ms_id, uint32_t size)
+{
+  osMemorySlab_t *ms = ms_id;
+  uint32_t        size_class;
+
+  /* Check parameters */
+  if ((ms == NULL) || (ms->id != ID_MEMORY_SLAB) || (size == 0U)) {
+    return (NULL);
+  }
+
+  size_class = SlabSizeClass(ms, size);
+  if (size_class == ms->class_count) {
+    return (NULL);
+  }
+
+  return (SlabAlloc(ms, size_class));
+}
+
+static osStatus_t svcMemorySlabFree(osMemorySlabId_t ms_id, void *block)
+{
+  osMemorySlab_t *ms = ms_id;
+
+  /* Check parameters */
+  if ((ms == NULL) || (ms->id != ID_MEMORY_SLAB)) {
+    return (osErrorParameter);
+  }
+
+  return (SlabFree(ms, block));
+}
+
+static osStatus_t svcMemorySlabGetStats(osMemorySlabId_t ms_id, osMemorySlabStats_t *stats)
+{
+  osMemorySlab_t      *ms = ms_id;
+  osMemorySlabClass_t *cls;
+  uint32_t             held;
+  uint32_t             block_size;
+
+  /* Check parameters */
+  if ((ms == NULL) || (ms->id != ID_MEMORY_SLAB) || (stats == NULL)) {
+    return (osErrorParameter);
+  }
+
+  memset(stats, 0, sizeof(osMemorySlabStats_t));
+
+  BEGIN_CRITICAL_SECTION
+
+  stats->page_size   = 1UL << ms->page_log2;
+  stats->page_count  = ms->page_count;
+  stats->page_free   = ms->page_free;
+  stats->class_count = ms->class_count;
+
+  for (uint32_t i = 0U; i < ms->class_count; i++) {
+    cls = &ms->classes[i];
+    block_size = 1UL << (ms->min_log2 + i);
+    stats->classes[i].block_size      = block_size;
+    stats->classes[i].page_count      = cls->page_count;
+    stats->classes[i].used_blocks     = cls->used_blocks;
+    stats->classes[i].max_used_blocks = cls->max_used_blocks;
+    stats->used_size += cls->used_blocks * block_size;
+  }
+
+  END_CRITICAL_SECTION
+
+  held = (stats->page_count - stats->page_free) << ms->page_log2;
+  stats->waste_size = held - stats->used_size;
+  if (held > (0xFFFFFFFFU / 100U)) {
+    stats->fill = stats->used_size / (held / 100U);
+  }
+  else if (held != 0U) {
+    stats->fill = (stats->used_size * 100U) / held;
+  }
+
+  return (osOK);
+}
+
+static osStatus_t svcMemorySlabDelete(osMemorySlabId_t ms_id)
+{
+  osMemorySlab_t *ms = ms_id;
+
+  /* Check parameters */
+  if ((ms == NULL) || (ms->id != ID_MEMORY_SLAB)) {
+    return (osErrorParameter);
+  }
+
+  /* Mark object as invalid */
+  ms->id = ID_INVALID;
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          osMemorySlabId_t osMemorySlabNew(uint32_t min_size, uint32_t max_size, const osMemorySlabAttr_t *attr)
+ * @brief       Create and Initialize a Memory Slab object.
+ * @param[in]   min_size  smallest memory block size in bytes.
+ * @param[in]   max_size  largest memory block size in bytes.
+ * @param[in]   attr      memory slab attributes.
+ * @return      memory slab ID for reference by other functions or NULL in case of error.
+ */
+osMemorySlabId_t osMemorySlabNew(uint32_t min_size, uint32_t max_size, const osMemorySlabAttr_t *attr)
+{
+  osMemorySlabId_t ms_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    ms_id = NULL;
+  }
+  else {
+    ms_id = (osMemorySlabId_t)SVC_3(min_size, max_size, attr, svcMemorySlabNew);
+  }
+
+  return (ms_id);
+}
+
+/**
+ * @fn          const char *osMemorySlabGetName(osMemorySlabId_t ms_id)
+ * @brief       Get name of a Memory Slab object.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osMemorySlabGetName(osMemorySlabId_t ms_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)SVC_1(ms_id, svcMemorySlabGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          void *osMemorySlabAlloc(osMemorySlabId_t ms_id, uint32_t size)
+ * @brief       Allocate a memory block of the smallest size class that fits size.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[in]   size    size of the memory block in bytes.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osMemorySlabAlloc(osMemorySlabId_t ms_id, uint32_t size)
+{
+  void *memory;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    memory = svcMemorySlabAlloc(ms_id, size);
+  }
+  else {
+    memory = (void *)SVC_2(ms_id, size, svcMemorySlabAlloc);
+  }
+
+  return (memory);
+}
+
+/**
+ * @fn          osStatus_t osMemorySlabFree(osMemorySlabId_t ms_id, void *block)
+ * @brief       Return an allocated memory block back to a Memory Slab.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabFree(osMemorySlabId_t ms_id, void *block)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = svcMemorySlabFree(ms_id, block);
+  }
+  else {
+    status = (osStatus_t)SVC_2(ms_id, block, svcMemorySlabFree);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osMemorySlabGetStats(osMemorySlabId_t ms_id, osMemorySlabStats_t *stats)
+ * @brief       Get fill and waste statistics of a Memory Slab.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @param[out]  stats   pointer to buffer for the statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabGetStats(osMemorySlabId_t ms_id, osMemorySlabStats_t *stats)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = svcMemorySlabGetStats(ms_id, stats);
+  }
+  else {
+    status = (osStatus_t)SVC_2(ms_id, stats, svcMemorySlabGetStats);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osMemorySlabDelete(osMemorySlabId_t ms_id)
+ * @brief       Delete a Memory Slab object.
+ * @param[in]   ms_id   memory slab ID obtained by \ref osMemorySlabNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemorySlabDelete(osMemorySlabId_t ms_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_1(ms_id, svcMemorySlabDelete);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
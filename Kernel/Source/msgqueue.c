@@ -31,49 +31,138 @@
 #include <string.h>
 #include "kernel_lib.h"
 
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define MESSAGE_ALLOCATED             (1U << 0)   ///< Block owned by a sender (osMessageQueueAlloc)
+#define MESSAGE_BORROWED              (1U << 1)   ///< Block owned by a receiver (osMessageQueueReceiveRef)
+
+/* Priority sub-list of a Message */
+#define MESSAGE_LEVEL(prio)                                                    \
+  (((uint32_t)(prio) < (MSG_PRIO_LEVELS - 1U)) ? (uint32_t)(prio) : (MSG_PRIO_LEVELS - 1U))
+
 /*******************************************************************************
  *  Helper functions
  ******************************************************************************/
 
-static osMessage_t *MessagePut(osMessageQueue_t *mq, const void *msg_ptr, uint8_t msg_prio)
+/**
+ * @brief       Get number of trailing zeros.
+ * @param[in]   value   non-zero value.
+ * @return      number of trailing zeros.
+ */
+__STATIC_INLINE
+uint32_t MessageCountTrailingZeros(uint32_t value)
 {
-  queue_t     *que;
-  osMessage_t *msg;
+  return (31U - __CLZ(value & (0U - value)));
+}
 
-  /* Try to allocate memory */
-  msg = krnMemoryPoolAlloc(&mq->mp_info);
-  if (msg != NULL) {
-    /* Copy Message */
-    memcpy(&msg[1], msg_ptr, mq->msg_size);
-    msg->id = ID_MESSAGE;
-    msg->flags = 0U;
-    msg->priority = msg_prio;
+__STATIC_INLINE
+void MessageBmpSet(osMessageQueue_t *mq, uint32_t level)
+{
+#if (MSG_PRIO_LEVELS > 32U)
+  mq->msg_bmp.group |= (1UL << (level >> 5U));
+  mq->msg_bmp.map[level >> 5U] |= (1UL << (level & 31U));
+#else
+  mq->msg_bmp.map[0] |= (1UL << level);
+#endif
+}
 
-    BEGIN_CRITICAL_SECTION
+__STATIC_INLINE
+void MessageBmpClear(osMessageQueue_t *mq, uint32_t level)
+{
+#if (MSG_PRIO_LEVELS > 32U)
+  mq->msg_bmp.map[level >> 5U] &= ~(1UL << (level & 31U));
+  if (mq->msg_bmp.map[level >> 5U] == 0U) {
+    mq->msg_bmp.group &= ~(1UL << (level >> 5U));
+  }
+#else
+  mq->msg_bmp.map[0] &= ~(1UL << level);
+#endif
+}
 
-    /* Put Message into Queue */
-    que = &mq->msg_queue;
-    if (msg_prio != 0U) {
-      for (que = que->next; que != &mq->msg_queue; que = que->next) {
-        if (GetMessageByQueue(que)->priority < msg_prio) {
-          break;
-        }
-      }
+/**
+ * @brief       Get the nearest non-empty priority level above a level.
+ * @param[in]   mq      message queue object.
+ * @param[in]   level   priority level.
+ * @return      priority level or MSG_PRIO_LEVELS if all higher levels are empty.
+ */
+static uint32_t MessageBmpNext(osMessageQueue_t *mq, uint32_t level)
+{
+  uint32_t word = level >> 5U;
+  uint32_t bits;
+
+  /* Clear the bits of the level and all lower levels */
+  bits = mq->msg_bmp.map[word] & (uint32_t)~((2UL << (level & 31U)) - 1U);
+#if (MSG_PRIO_LEVELS > 32U)
+  if (bits == 0U) {
+    bits = mq->msg_bmp.group & (uint32_t)~((2UL << word) - 1U);
+    if (bits == 0U) {
+      return (MSG_PRIO_LEVELS);
     }
+    word = MessageCountTrailingZeros(bits);
+    bits = mq->msg_bmp.map[word];
+  }
+#else
+  if (bits == 0U) {
+    return (MSG_PRIO_LEVELS);
+  }
+#endif
 
-    QueueAppend(que, &msg->msg_que);
-    mq->msg_count++;
+  return ((word << 5U) + MessageCountTrailingZeros(bits));
+}
 
-    END_CRITICAL_SECTION
+static void MessageEnqueue(osMessageQueue_t *mq, osMessage_t *msg, uint8_t msg_prio)
+{
+  osMessage_t *prev;
+  queue_t     *que;
+  uint32_t     level = MESSAGE_LEVEL(msg_prio);
+
+  msg->id = ID_MESSAGE;
+  msg->flags = 0U;
+  msg->priority = msg_prio;
+
+  BEGIN_CRITICAL_SECTION
+
+  prev = mq->msg_tail[level];
+  if (prev != NULL) {
+#if (MSG_PRIO_LEVELS < 256U)
+    if (level == (MSG_PRIO_LEVELS - 1U)) {
+      /* The top sub-list is shared, keep it in priority order */
+      while ((prev != NULL) && (prev->priority < msg_prio)) {
+        que = prev->msg_que.prev;
+        prev = (que != &mq->msg_queue) ? GetMessageByQueue(que) : NULL;
+      }
+    }
+#endif
+    if (prev == mq->msg_tail[level]) {
+      mq->msg_tail[level] = msg;
+    }
+  }
+  else {
+    /* Start the sub-list after the nearest higher priority level */
+    level = MessageBmpNext(mq, level);
+    if (level < MSG_PRIO_LEVELS) {
+      prev = mq->msg_tail[level];
+    }
+    level = MESSAGE_LEVEL(msg_prio);
+    MessageBmpSet(mq, level);
+    mq->msg_tail[level] = msg;
   }
 
-  return (msg);
+  /* Put Message into Queue */
+  que = (prev != NULL) ? prev->msg_que.next : mq->msg_queue.next;
+  QueueAppend(que, &msg->msg_que);
+  mq->msg_count++;
+
+  END_CRITICAL_SECTION
 }
 
-static osMessage_t *MessageGet(osMessageQueue_t *mq, void *msg_ptr, uint8_t *msg_prio)
+static osMessage_t *MessageExtract(osMessageQueue_t *mq)
 {
   queue_t     *que;
   osMessage_t *msg;
+  uint32_t     level;
 
   que = &mq->msg_queue;
 
@@ -84,33 +173,184 @@ static osMessage_t *MessageGet(osMessageQueue_t *mq, void *msg_ptr, uint8_t *msg
     msg = GetMessageByQueue(QueueExtract(que));
     mq->msg_count--;
 
+    /* Update the sub-list of the Message priority */
+    level = MESSAGE_LEVEL(msg->priority);
+    if (mq->msg_tail[level] == msg) {
+      mq->msg_tail[level] = NULL;
+      MessageBmpClear(mq, level);
+    }
+
     END_CRITICAL_SECTION
+  }
+  else {
+    msg = NULL;
+  }
+
+  return (msg);
+}
+
+static void MessageFree(osMessageQueue_t *mq, osMessage_t *msg)
+{
+  msg->id = ID_INVALID;
+  krnMemoryPoolFree(&mq->mp_info, msg);
+}
+
+static osMessage_t *MessagePut(osMessageQueue_t *mq, const void *msg_ptr, uint8_t msg_prio)
+{
+  osMessage_t *msg;
+
+  /* Try to allocate memory */
+  msg = krnMemoryPoolAlloc(&mq->mp_info);
+  if (msg != NULL) {
+    /* Copy Message */
+    memcpy(&msg[1], msg_ptr, mq->msg_size);
+    MessageEnqueue(mq, msg, msg_prio);
+  }
+
+  return (msg);
+}
 
+static osMessage_t *MessageGet(osMessageQueue_t *mq, void *msg_ptr, uint8_t *msg_prio)
+{
+  osMessage_t *msg;
+
+  msg = MessageExtract(mq);
+  if (msg != NULL) {
     /* Copy Message */
     memcpy(msg_ptr, &msg[1], mq->msg_size);
     if (msg_prio != NULL) {
       *msg_prio = msg->priority;
     }
     /* Free memory */
-    msg->id = ID_INVALID;
-    krnMemoryPoolFree(&mq->mp_info, msg);
+    MessageFree(mq, msg);
   }
-  else {
-    msg = NULL;
+
+  return (msg);
+}
+
+/**
+ * @brief       Get the Message owning a payload returned to the application.
+ * @param[in]   mq        message queue object.
+ * @param[in]   msg_ptr   payload pointer.
+ * @param[in]   flags     accepted ownership flags.
+ * @return      message object or NULL if the payload is not owned by the application.
+ */
+static osMessage_t *MessageCheck(osMessageQueue_t *mq, const void *msg_ptr, uint8_t flags)
+{
+  osMessage_t *msg;
+
+  if (msg_ptr == NULL) {
+    return (NULL);
+  }
+
+  msg = &((osMessage_t *)msg_ptr)[-1];
+  if (((void *)msg < mq->mp_info.block_base) || ((void *)msg >= mq->mp_info.block_lim) ||
+      ((((uint32_t)msg - (uint32_t)mq->mp_info.block_base) % mq->mp_info.block_size) != 0U) ||
+      (msg->id != ID_MESSAGE) || ((msg->flags & flags) == 0U)) {
+    return (NULL);
   }
 
   return (msg);
 }
 
-static void MessageReset(osMessageQueue_t *mq)
+/**
+ * @brief       Pass a Message to a Thread waiting to receive it.
+ * @param[in]   mq      message queue object.
+ * @param[in]   thread  thread object waiting in the get queue.
+ * @param[in]   msg     message object taken out of the queue or just filled.
+ * @return      value to wake up the thread with.
+ */
+static uint32_t MessageDeliver(osMessageQueue_t *mq, osThread_t *thread, osMessage_t *msg)
 {
-  BEGIN_CRITICAL_SECTION
+  winfo_msgque_t *winfo = &thread->winfo.msgque;
+  uint32_t        ret_val;
 
-  mq->msg_count = 0U;
-  QueueReset(&mq->msg_queue);
-  krnMemoryPoolReset(&mq->mp_info);
+  if ((uint8_t *)winfo->msg_prio != NULL) {
+    *((uint8_t *)winfo->msg_prio) = msg->priority;
+  }
 
-  END_CRITICAL_SECTION
+  if (winfo->msg != NULL) {
+    /* Copy Message */
+    memcpy(winfo->msg, &msg[1], mq->msg_size);
+    MessageFree(mq, msg);
+    ret_val = (uint32_t)osOK;
+  }
+  else {
+    /* Lend the block to the receiver */
+    msg->flags = MESSAGE_BORROWED;
+    ret_val = (uint32_t)&msg[1];
+  }
+
+  return (ret_val);
+}
+
+/**
+ * @brief       Send a filled Message block to the first waiting receiver or into the Queue.
+ * @param[in]   mq        message queue object.
+ * @param[in]   msg       message object.
+ * @param[in]   msg_prio  message priority.
+ * @param[in]   dispatch  dispatch flag for the receiving thread.
+ */
+static void MessageSend(osMessageQueue_t *mq, osMessage_t *msg, uint8_t msg_prio, dispatch_t dispatch)
+{
+  osThread_t *thread;
+
+  if (!isQueueEmpty(&mq->wait_get_queue)) {
+    /* Wakeup waiting Thread with highest Priority */
+    thread = GetThreadByQueue(mq->wait_get_queue.next);
+    msg->id = ID_MESSAGE;
+    msg->priority = msg_prio;
+    krnThreadWaitExit(thread, MessageDeliver(mq, thread, msg), dispatch);
+  }
+  else {
+    MessageEnqueue(mq, msg, msg_prio);
+  }
+}
+
+/**
+ * @brief       Hand free Message blocks to Threads waiting to send or allocate.
+ * @param[in]   mq  message queue object.
+ */
+static void MessageSpaceNotify(osMessageQueue_t *mq)
+{
+  osMessage_t    *msg;
+  osThread_t     *thread;
+  winfo_msgque_t *winfo;
+  uint32_t        ret_val;
+
+  while (!isQueueEmpty(&mq->wait_put_queue)) {
+    /* Try to allocate memory */
+    msg = krnMemoryPoolAlloc(&mq->mp_info);
+    if (msg == NULL) {
+      break;
+    }
+    /* Get waiting Thread with highest Priority */
+    thread = GetThreadByQueue(mq->wait_put_queue.next);
+    winfo = &thread->winfo.msgque;
+    if (winfo->msg != NULL) {
+      /* Copy Message and pass it on */
+      memcpy(&msg[1], winfo->msg, mq->msg_size);
+      MessageSend(mq, msg, (uint8_t)winfo->msg_prio, DISPATCH_NO);
+      ret_val = (uint32_t)osOK;
+    }
+    else {
+      /* Hand the block to the allocating Thread */
+      msg->id = ID_MESSAGE;
+      msg->flags = MESSAGE_ALLOCATED;
+      ret_val = (uint32_t)&msg[1];
+    }
+    krnThreadWaitExit(thread, ret_val, DISPATCH_NO);
+  }
+}
+
+static void MessageReset(osMessageQueue_t *mq)
+{
+  osMessage_t *msg;
+
+  /* Blocks held by the application stay allocated */
+  for (msg = MessageExtract(mq); msg != NULL; msg = MessageExtract(mq)) {
+    MessageFree(mq, msg);
+  }
 }
 
 /*******************************************************************************
@@ -123,34 +363,81 @@ static osMessageQueueId_t svcMessageQueueNew(uint32_t msg_count, uint32_t msg_si
   void             *mq_mem;
   uint32_t          mq_size;
   uint32_t          block_size;
+  const char       *name;
+  uint8_t           flags;
 
   /* Check parameters */
-  if ((msg_count == 0U) || (msg_size  == 0U) || (attr == NULL)) {
+  if ((msg_count == 0U) || (msg_size  == 0U)) {
     return (NULL);
   }
 
-  mq      = attr->cb_mem;
-  mq_mem  = attr->mq_mem;
-  mq_size = attr->mq_size;
   block_size = ((msg_size + 3U) & ~3UL) + sizeof(osMessage_t);
-
-  /* Check parameters */
-  if (((__CLZ(msg_count) + __CLZ(block_size)) < 32U) ||
-      (mq == NULL) || (((uint32_t)mq & 3U) != 0U) || (attr->cb_size < sizeof(osMessageQueue_t)) ||
-      (mq_mem == NULL) || (((uint32_t)mq_mem & 3U) != 0U) || (mq_size < (msg_count * block_size))) {
+  if ((__CLZ(msg_count) + __CLZ(block_size)) < 32U) {
     return (NULL);
   }
 
+  if (attr != NULL) {
+    mq      = attr->cb_mem;
+    mq_mem  = attr->mq_mem;
+    mq_size = attr->mq_size;
+    name    = attr->name;
+
+    /* Check parameters */
+    if (mq != NULL) {
+      if ((((uint32_t)mq & 3U) != 0U) || (attr->cb_size < sizeof(osMessageQueue_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+    if (mq_mem != NULL) {
+      if ((((uint32_t)mq_mem & 3U) != 0U) || (mq_size < (msg_count * block_size))) {
+        return (NULL);
+      }
+    }
+    else if (mq_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    mq     = NULL;
+    mq_mem = NULL;
+    name   = NULL;
+  }
+
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (mq == NULL) {
+    mq = krnObjectMemAlloc(osConfig.mpi.message_queue, sizeof(osMessageQueue_t));
+    if (mq == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
+  }
+  if (mq_mem == NULL) {
+    mq_mem = krnObjectMemAlloc(NULL, msg_count * block_size);
+    if (mq_mem == NULL) {
+      if ((flags & FLAGS_OBJECT_MEM) != 0U) {
+        krnObjectMemFree(osConfig.mpi.message_queue, mq);
+      }
+      return (NULL);
+    }
+    flags |= FLAGS_DATA_MEM;
+  }
+
   /* Initialize control block */
   mq->id = ID_MESSAGE_QUEUE;
-  mq->flags = 0U;
-  mq->name = attr->name;
+  mq->flags = flags;
+  mq->name = name;
   mq->msg_size = msg_size;
   mq->msg_count = 0U;
   QueueReset(&mq->wait_put_queue);
   QueueReset(&mq->wait_get_queue);
   QueueReset(&mq->msg_queue);
   QueueReset(&mq->post_queue);
+  memset(&mq->msg_bmp, 0, sizeof(mq->msg_bmp));
+  memset(mq->msg_tail, 0, sizeof(mq->msg_tail));
   krnMemoryPoolInit(msg_count, block_size, mq_mem, &mq->mp_info);
 
   return (mq);
@@ -181,8 +468,9 @@ static osStatus_t svcMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_p
     return (osErrorParameter);
   }
 
-  /* Check if Thread is waiting to receive a Message */
-  if (!isQueueEmpty(&mq->wait_get_queue)) {
+  /* Check if Thread is waiting to receive a Message into its buffer */
+  if (!isQueueEmpty(&mq->wait_get_queue) &&
+      (GetThreadByQueue(mq->wait_get_queue.next)->winfo.msgque.msg != NULL)) {
     /* Wakeup waiting Thread with highest Priority */
     thread = GetThreadByQueue(mq->wait_get_queue.next);
     krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
@@ -194,9 +482,12 @@ static osStatus_t svcMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_p
     status = osOK;
   }
   else {
-    /* Try to put Message into Queue */
-    msg = MessagePut(mq, msg_ptr, msg_prio);
+    /* Try to allocate memory */
+    msg = krnMemoryPoolAlloc(&mq->mp_info);
     if (msg != NULL) {
+      /* Copy Message and pass it to a receiver or into Queue */
+      memcpy(&msg[1], msg_ptr, mq->msg_size);
+      MessageSend(mq, msg, msg_prio, DISPATCH_YES);
       status = osOK;
     }
     else {
@@ -223,7 +514,6 @@ static osStatus_t svcMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, ui
 {
   osMessageQueue_t *mq = mq_id;
   osMessage_t      *msg;
-  osThread_t       *thread;
   winfo_msgque_t   *winfo;
   osStatus_t        status;
 
@@ -238,15 +528,8 @@ static osStatus_t svcMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, ui
   if (msg != NULL) {
     /* Check if Thread is waiting to send a Message */
     if (!isQueueEmpty(&mq->wait_put_queue)) {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(mq->wait_put_queue.next);
-      winfo = &thread->winfo.msgque;
-      /* Try to put Message into Queue */
-      msg = MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
-      if (msg != NULL) {
-        /* Wakeup waiting Thread with highest Priority */
-        krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-      }
+      MessageSpaceNotify(mq);
+      SchedDispatch(NULL);
     }
     status = osOK;
   }
@@ -269,6 +552,131 @@ static osStatus_t svcMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, ui
   return (status);
 }
 
+static void *svcMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  winfo_msgque_t   *winfo;
+  void             *msg_ptr;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (NULL);
+  }
+
+  /* Try to allocate memory */
+  msg = krnMemoryPoolAlloc(&mq->mp_info);
+  if (msg != NULL) {
+    msg->id = ID_MESSAGE;
+    msg->flags = MESSAGE_ALLOCATED;
+    msg_ptr = &msg[1];
+  }
+  else if (timeout != 0U) {
+    /* Suspend current Thread */
+    msg_ptr = (void *)krnThreadWaitEnter(ThreadWaitingQueuePut, &mq->wait_put_queue, timeout);
+    if (msg_ptr == (void *)osErrorTimeout) {
+      msg_ptr = NULL;
+    }
+    else {
+      winfo           = &ThreadGetRunning()->winfo.msgque;
+      winfo->msg      = NULL;
+      winfo->msg_prio = 0U;
+    }
+  }
+  else {
+    msg_ptr = NULL;
+  }
+
+  return (msg_ptr);
+}
+
+static osStatus_t svcMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  msg = MessageCheck(mq, msg_ptr, MESSAGE_ALLOCATED);
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  MessageSend(mq, msg, msg_prio, DISPATCH_YES);
+
+  return (osOK);
+}
+
+static void *svcMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  winfo_msgque_t   *winfo;
+  void             *msg_ptr;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (NULL);
+  }
+
+  /* Get Message from Queue */
+  msg = MessageExtract(mq);
+  if (msg != NULL) {
+    msg->flags = MESSAGE_BORROWED;
+    if (msg_prio != NULL) {
+      *msg_prio = msg->priority;
+    }
+    msg_ptr = &msg[1];
+  }
+  else if (timeout != 0U) {
+    /* Suspend current Thread */
+    msg_ptr = (void *)krnThreadWaitEnter(ThreadWaitingQueueGet, &mq->wait_get_queue, timeout);
+    if (msg_ptr == (void *)osErrorTimeout) {
+      msg_ptr = NULL;
+    }
+    else {
+      winfo           = &ThreadGetRunning()->winfo.msgque;
+      winfo->msg      = NULL;
+      winfo->msg_prio = (uint32_t)msg_prio;
+    }
+  }
+  else {
+    msg_ptr = NULL;
+  }
+
+  return (msg_ptr);
+}
+
+static osStatus_t svcMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  msg = MessageCheck(mq, msg_ptr, MESSAGE_BORROWED | MESSAGE_ALLOCATED);
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  /* Free memory */
+  MessageFree(mq, msg);
+
+  /* Check if Threads are waiting to send Messages */
+  if (!isQueueEmpty(&mq->wait_put_queue)) {
+    MessageSpaceNotify(mq);
+    SchedDispatch(NULL);
+  }
+
+  return (osOK);
+}
+
 static uint32_t svcMessageQueueGetCapacity(osMessageQueueId_t mq_id)
 {
   osMessageQueue_t *mq = mq_id;
@@ -314,15 +722,12 @@ static uint32_t svcMessageQueueGetSpace(osMessageQueueId_t mq_id)
     return (0U);
   }
 
-  return (mq->mp_info.max_blocks - mq->msg_count);
+  return (mq->mp_info.max_blocks - mq->mp_info.used_blocks);
 }
 
 static osStatus_t svcMessageQueueReset(osMessageQueueId_t mq_id)
 {
   osMessageQueue_t *mq = mq_id;
-  osMessage_t      *msg;
-  osThread_t       *thread;
-  winfo_msgque_t   *winfo;
 
   /* Check parameters */
   if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
@@ -333,19 +738,7 @@ static osStatus_t svcMessageQueueReset(osMessageQueueId_t mq_id)
   MessageReset(mq);
   /* Check if Threads are waiting to send Messages */
   if (!isQueueEmpty(&mq->wait_put_queue)) {
-    do {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(mq->wait_put_queue.next);
-      winfo = &thread->winfo.msgque;
-      /* Try to put Message into Queue */
-      msg = MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
-      if (msg == NULL) {
-        break;
-      }
-      /* Wakeup waiting Thread with highest Priority */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    } while (!isQueueEmpty(&mq->wait_put_queue));
-
+    MessageSpaceNotify(mq);
     SchedDispatch(NULL);
   }
 
@@ -367,6 +760,15 @@ static osStatus_t svcMessageQueueDelete(osMessageQueueId_t mq_id)
 
   /* Mark object as invalid */
   mq->id = ID_INVALID;
+  krnPostProcessCancel((osObject_t *)mq);
+
+  /* Free data and object memory */
+  if ((mq->flags & FLAGS_DATA_MEM) != 0U) {
+    krnObjectMemFree(NULL, mq->mp_info.block_base);
+  }
+  if ((mq->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.message_queue, mq);
+  }
 
   return (osOK);
 }
@@ -431,6 +833,102 @@ osStatus_t isrMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
   return (status);
 }
 
+__STATIC_INLINE
+void *isrMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE) || (timeout != 0U)) {
+    return (NULL);
+  }
+
+  /* Try to allocate memory */
+  msg = krnMemoryPoolAlloc(&mq->mp_info);
+  if (msg == NULL) {
+    return (NULL);
+  }
+
+  msg->id = ID_MESSAGE;
+  msg->flags = MESSAGE_ALLOCATED;
+
+  return (&msg[1]);
+}
+
+__STATIC_INLINE
+osStatus_t isrMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  msg = MessageCheck(mq, msg_ptr, MESSAGE_ALLOCATED);
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  /* Put Message into Queue */
+  MessageEnqueue(mq, msg, msg_prio);
+  /* Register post ISR processing */
+  krnPostProcess((osObject_t *)mq);
+
+  return (osOK);
+}
+
+__STATIC_INLINE
+void *isrMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE) || (timeout != 0U)) {
+    return (NULL);
+  }
+
+  /* Get Message from Queue */
+  msg = MessageExtract(mq);
+  if (msg == NULL) {
+    return (NULL);
+  }
+
+  msg->flags = MESSAGE_BORROWED;
+  if (msg_prio != NULL) {
+    *msg_prio = msg->priority;
+  }
+
+  return (&msg[1]);
+}
+
+__STATIC_INLINE
+osStatus_t isrMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  msg = MessageCheck(mq, msg_ptr, MESSAGE_BORROWED | MESSAGE_ALLOCATED);
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  /* Free memory */
+  MessageFree(mq, msg);
+  /* Register post ISR processing */
+  krnPostProcess((osObject_t *)mq);
+
+  return (osOK);
+}
+
 /*******************************************************************************
  *  Post ISR processing
  ******************************************************************************/
@@ -443,31 +941,21 @@ void krnMessageQueuePostProcess(osMessageQueue_t *mq)
 {
   osMessage_t    *msg;
   osThread_t     *thread;
-  winfo_msgque_t *winfo;
 
-  /* Check if Thread is waiting to receive a Message */
-  if (!isQueueEmpty(&mq->wait_get_queue)) {
-    /* Get waiting Thread with highest Priority */
-    thread = GetThreadByQueue(mq->wait_get_queue.next);
-    winfo = &thread->winfo.msgque;
+  /* Check if Threads are waiting to receive Messages */
+  while (!isQueueEmpty(&mq->wait_get_queue)) {
     /* Try to get Message from Queue */
-    msg = MessageGet(mq, winfo->msg, (uint8_t *)winfo->msg_prio);
-    if (msg != NULL) {
-      /* Wakeup waiting Thread */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    }
-  }
-  else if (!isQueueEmpty(&mq->wait_put_queue)) {
-    /* Get waiting Thread with highest Priority */
-    thread = GetThreadByQueue(mq->wait_put_queue.next);
-    winfo = &thread->winfo.msgque;
-    /* Try to put Message into Queue */
-    msg = MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
-    if (msg != NULL) {
-      /* Wakeup waiting Thread */
-      krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
+    msg = MessageExtract(mq);
+    if (msg == NULL) {
+      break;
     }
+    /* Wakeup waiting Thread with highest Priority */
+    thread = GetThreadByQueue(mq->wait_get_queue.next);
+    krnThreadWaitExit(thread, MessageDeliver(mq, thread, msg), DISPATCH_NO);
   }
+
+  /* Check if Threads are waiting to send Messages */
+  MessageSpaceNotify(mq);
 }
 
 /*******************************************************************************
@@ -568,6 +1056,105 @@ osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *m
   return (status);
 }
 
+/**
+ * @fn          void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+ * @brief       Allocate a Message block from a Queue to fill in place or timeout if Queue is full.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the message payload or NULL in case of error.
+ */
+void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+{
+  void *msg_ptr;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    msg_ptr = isrMessageQueueAlloc(mq_id, timeout);
+  }
+  else {
+    msg_ptr = (void *)SVC_2(mq_id, timeout, svcMessageQueueAlloc);
+    if ((int32_t)msg_ptr == osThreadWait) {
+      msg_ptr = (void *)ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)msg_ptr == osErrorTimeout) || ((osStatus_t)msg_ptr == osErrorResource)) {
+        msg_ptr = NULL;
+      }
+    }
+  }
+
+  return (msg_ptr);
+}
+
+/**
+ * @fn          osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+ * @brief       Put a Message block obtained by \ref osMessageQueueAlloc into a Queue without copying.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   message payload obtained by \ref osMessageQueueAlloc.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = isrMessageQueueSend(mq_id, msg_ptr, msg_prio);
+  }
+  else {
+    status = (osStatus_t)SVC_3(mq_id, msg_ptr, msg_prio, svcMessageQueueSend);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          void *osMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+ * @brief       Get a Message from a Queue without copying or timeout if Queue is empty.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[out]  msg_prio  pointer to buffer for message priority or NULL.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the message payload or NULL in case of error.
+ */
+void *osMessageQueueReceiveRef(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+{
+  void *msg_ptr;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    msg_ptr = isrMessageQueueReceiveRef(mq_id, msg_prio, timeout);
+  }
+  else {
+    msg_ptr = (void *)SVC_3(mq_id, msg_prio, timeout, svcMessageQueueReceiveRef);
+    if ((int32_t)msg_ptr == osThreadWait) {
+      msg_ptr = (void *)ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)msg_ptr == osErrorTimeout) || ((osStatus_t)msg_ptr == osErrorResource)) {
+        msg_ptr = NULL;
+      }
+    }
+  }
+
+  return (msg_ptr);
+}
+
+/**
+ * @fn          osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+ * @brief       Return a Message block obtained by \ref osMessageQueueReceiveRef or
+ *              \ref osMessageQueueAlloc back to a Queue.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   message payload owned by the caller.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = isrMessageQueueRelease(mq_id, msg_ptr);
+  }
+  else {
+    status = (osStatus_t)SVC_2(mq_id, msg_ptr, svcMessageQueueRelease);
+  }
+
+  return (status);
+}
+
 /**
  * @fn          uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
  * @brief       Get maximum number of messages in a Message Queue.
@@ -36,6 +36,100 @@
 
 #define osMutexLockLimit              (255U)
 
+/* Owner word: 0 - free, thread - locked in thread mode, thread|KERNEL - the
+   lock state is kept by the kernel (holder, cnt, mutex_que) */
+#define MUTEX_LOCK_KERNEL             (1UL)
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+/**
+ * @brief       Get the priority a mutex owner must run at: its base priority,
+ *              the highest priority of the threads waiting for its priority
+ *              inheritance mutexes or the ceiling of its priority ceiling
+ *              mutexes.
+ * @param[in]   thread  thread object.
+ * @return      priority.
+ */
+static int16_t MutexOwnerPriority(osThread_t *thread)
+{
+  osMutex_t  *mutex;
+  queue_t    *que;
+  int16_t     priority;
+  osThread_t *wthread;
+
+  priority = ThreadBasePriority(thread);
+
+  for (que = thread->mutex_que.next; que != &thread->mutex_que; que = que->next) {
+    mutex = GetMutexByQueque(que);
+    if (((mutex->attr & osMutexPrioInherit) != 0U) && !isQueueEmpty(&mutex->wait_que)) {
+      wthread = GetThreadByQueue(mutex->wait_que.next);
+      if (wthread->priority > priority) {
+        priority = wthread->priority;
+      }
+    }
+    else if (((mutex->attr & osMutexPrioCeiling) != 0U) && (mutex->ceiling > priority)) {
+      priority = mutex->ceiling;
+    }
+  }
+
+  return (priority);
+}
+
+/**
+ * @brief       Move the ownership of a mutex locked in thread mode to the
+ *              kernel, so that the lock counter, owner list and priority
+ *              inheritance apply to it.
+ * @param[in]   mutex   mutex object.
+ */
+static void MutexLockTake(osMutex_t *mutex)
+{
+  osThread_t *thread;
+
+  if ((mutex->cnt == 0U) && (mutex->lock != 0U)) {
+    thread = (osThread_t *)mutex->lock;
+    mutex->holder = thread;
+    mutex->cnt = 1U;
+    mutex->lock = (uint32_t)thread | MUTEX_LOCK_KERNEL;
+    QueueAppend(&thread->mutex_que, &mutex->mutex_que);
+  }
+}
+
+/**
+ * @brief       Try to lock a free mutex without a service call.
+ * @param[in]   mutex   mutex object.
+ * @return      true - mutex acquired, false - service call is required.
+ */
+__STATIC_FORCEINLINE
+bool MutexFastAcquire(osMutex_t *mutex)
+{
+  if ((mutex == NULL) || (mutex->id != ID_MUTEX) ||
+      ((mutex->attr & (osMutexRobust | osMutexPrioCeiling)) != 0U) ||
+      (osInfo.kernel.state != osKernelRunning)) {
+    return (false);
+  }
+
+  return (AtomicCompareSwap(&mutex->lock, 0U, (uint32_t)ThreadGetRunning()));
+}
+
+/**
+ * @brief       Try to unlock a mutex locked in thread mode without a service
+ *              call.
+ * @param[in]   mutex   mutex object.
+ * @return      true - mutex released, false - service call is required.
+ */
+__STATIC_FORCEINLINE
+bool MutexFastRelease(osMutex_t *mutex)
+{
+  if ((mutex == NULL) || (mutex->id != ID_MUTEX) ||
+      (osInfo.kernel.state != osKernelRunning)) {
+    return (false);
+  }
+
+  return (AtomicCompareSwap(&mutex->lock, (uint32_t)ThreadGetRunning(), 0U));
+}
+
 /*******************************************************************************
  *  Library functions
  ******************************************************************************/
@@ -61,69 +155,132 @@ void krnMutexOwnerRelease(queue_t *que)
         krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
         mutex->holder = thread;
         mutex->cnt = 1U;
+        mutex->lock = (uint32_t)thread | MUTEX_LOCK_KERNEL;
         QueueAppend(&thread->mutex_que, &mutex->mutex_que);
+        if ((mutex->attr & osMutexPrioCeiling) != 0U) {
+          krnMutexOwnerPriorityRestore(thread);
+        }
+      }
+      else {
+        mutex->lock = 0U;
       }
     }
   }
 }
 
-/*******************************************************************************
- *  Helper functions
- ******************************************************************************/
-
-static void RestoreThreadPriority(osThread_t *thread)
+/**
+ * @brief       Set the priority of a thread to its base priority or to the
+ *              highest priority of the threads waiting for its mutexes, and
+ *              pass the change on along the chain of mutexes it waits for.
+ * @param[in]   thread  thread object.
+ */
+void krnMutexOwnerPriorityRestore(osThread_t *thread)
 {
-  osMutex_t  *mutex;
-  queue_t    *que;
-  int8_t      priority;
-  osThread_t *wthread;
+  osMutex_t *mutex;
+  uint32_t   depth;
+  int16_t    priority;
 
-  priority = thread->base_priority;
+  for (depth = 0U; depth < MUTEX_INHERIT_DEPTH; depth++) {
+    priority = MutexOwnerPriority(thread);
+    if (priority == thread->priority) {
+      break;
+    }
 
-  if (!isQueueEmpty(&thread->mutex_que)) {
-    que = thread->mutex_que.next;
-    while (que != &thread->mutex_que) {
-      mutex = GetMutexByQueque(que);
-      if (!isQueueEmpty(&mutex->wait_que)) {
-        wthread = GetThreadByQueue(mutex->wait_que.next);
-        if (wthread->priority > priority) {
-          priority = wthread->priority;
-        }
-      }
-      que = que->next;
+    krnThreadSetPriority(thread, priority);
+
+    /* Check if the owner is blocked on another mutex */
+    if ((thread->state != ThreadWaitingMutex) || isQueueEmpty(&thread->thread_que)) {
+      break;
+    }
+
+    /* Keep the wait queue ordered by priority */
+    mutex = thread->winfo.mutex.mutex;
+    QueueRemoveEntry(&thread->thread_que);
+    krnThreadWaitQueueInsert(&mutex->wait_que, thread);
+
+    if ((mutex->attr & osMutexPrioInherit) == 0U) {
+      break;
     }
+    thread = mutex->holder;
   }
+}
 
-  krnThreadSetPriority(thread, priority);
+/**
+ * @brief       Update the owner of the mutex a thread no longer waits for
+ *              (timeout, abort or termination).
+ * @param[in]   thread  thread object removed from the mutex wait queue.
+ */
+void krnMutexWaitAbort(osThread_t *thread)
+{
+  osMutex_t *mutex = thread->winfo.mutex.mutex;
+
+  if (((mutex->attr & osMutexPrioInherit) != 0U) && (mutex->cnt != 0U)) {
+    krnMutexOwnerPriorityRestore(mutex->holder);
+  }
 }
 
+
 /*******************************************************************************
  *  Service Calls
  ******************************************************************************/
 
 static osMutexId_t svcMutexNew(const osMutexAttr_t *attr)
 {
-  osMutex_t *mutex;
-
-  /* Check parameters */
-  if (attr == NULL) {
-    return (NULL);
+  osMutex_t    *mutex;
+  const char   *name;
+  uint32_t      attr_bits;
+  osPriority_t  ceiling;
+  uint8_t       flags;
+
+  if (attr != NULL) {
+    mutex     = attr->cb_mem;
+    name      = attr->name;
+    attr_bits = attr->attr_bits;
+    ceiling   = attr->ceiling;
+
+    /* Check parameters */
+    if (mutex != NULL) {
+      if ((((uint32_t)mutex & 3U) != 0U) || (attr->cb_size < sizeof(osMutex_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    mutex     = NULL;
+    name      = NULL;
+    attr_bits = 0U;
+    ceiling   = osPriorityNone;
   }
 
-  mutex = attr->cb_mem;
+  /* Check priority ceiling */
+  if ((attr_bits & osMutexPrioCeiling) != 0U) {
+    if (((attr_bits & osMutexPrioInherit) != 0U) || !IsPriorityValid(ceiling)) {
+      return (NULL);
+    }
+  }
 
-  /* Check parameters */
-  if ((mutex == NULL) || (((uint32_t)mutex & 3U) != 0U) || (attr->cb_size < sizeof(osMutex_t))) {
-    return (NULL);
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (mutex == NULL) {
+    mutex = krnObjectMemAlloc(osConfig.mpi.mutex, sizeof(osMutex_t));
+    if (mutex == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
   }
 
   /* Initialize control block */
   mutex->id     = ID_MUTEX;
-  mutex->flags  = 0U;
-  mutex->attr   = (uint8_t)attr->attr_bits;
-  mutex->name   = attr->name;
+  mutex->flags  = flags;
+  mutex->attr   = (uint8_t)attr_bits;
+  mutex->name   = name;
   mutex->holder = NULL;
   mutex->cnt    = 0U;
+  mutex->lock   = 0U;
+  mutex->ceiling = (int16_t)ceiling;
   QueueReset(&mutex->wait_que);
   QueueReset(&mutex->mutex_que);
   QueueReset(&mutex->post_queue);
@@ -159,12 +316,25 @@ static osStatus_t svcMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
     return (osError);
   }
 
+  /* A thread above the priority ceiling must not lock the mutex */
+  if (((mutex->attr & osMutexPrioCeiling) != 0U) &&
+      (running_thread->base_priority > mutex->ceiling)) {
+    return (osErrorParameter);
+  }
+
+  MutexLockTake(mutex);
+
   /* Check if Mutex is not locked */
   if (mutex->cnt == 0U) {
     /* Acquire Mutex */
     mutex->holder = running_thread;
     mutex->cnt = 1U;
+    mutex->lock = (uint32_t)running_thread | MUTEX_LOCK_KERNEL;
     QueueAppend(&running_thread->mutex_que, &mutex->mutex_que);
+    /* Raise the owner to the priority ceiling */
+    if ((mutex->attr & osMutexPrioCeiling) != 0U) {
+      krnMutexOwnerPriorityRestore(running_thread);
+    }
     status = osOK;
   }
   else {
@@ -182,15 +352,14 @@ static osStatus_t svcMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
     else {
       /* Check if timeout is specified */
       if (timeout != 0U) {
+        /* Suspend current Thread */
+        running_thread->winfo.mutex.mutex = mutex;
+        status = krnThreadWaitEnter(ThreadWaitingMutex, &mutex->wait_que, timeout);
         /* Check if Priority inheritance protocol is enabled */
         if ((mutex->attr & osMutexPrioInherit) != 0U) {
-          /* Raise priority of owner Task if lower than priority of running Task */
-          if (mutex->holder->priority < running_thread->priority) {
-            krnThreadSetPriority(mutex->holder, running_thread->priority);
-          }
+          /* Raise priority of the owner and of the owners it waits for */
+          krnMutexOwnerPriorityRestore(mutex->holder);
         }
-        /* Suspend current Thread */
-        status = krnThreadWaitEnter(ThreadWaitingMutex, &mutex->wait_que, timeout);
       }
       else {
         status = osErrorResource;
@@ -217,6 +386,8 @@ static osStatus_t svcMutexRelease(osMutexId_t mutex_id)
     return (osError);
   }
 
+  MutexLockTake(mutex);
+
   /* Check if Mutex is not locked */
   if (mutex->cnt == 0U) {
     return (osErrorResource);
@@ -236,8 +407,8 @@ static osStatus_t svcMutexRelease(osMutexId_t mutex_id)
     QueueRemoveEntry(&mutex->mutex_que);
 
     /* Restore owner Thread priority */
-    if ((mutex->attr & osMutexPrioInherit) != 0U) {
-      RestoreThreadPriority(running_thread);
+    if ((mutex->attr & (osMutexPrioInherit | osMutexPrioCeiling)) != 0U) {
+      krnMutexOwnerPriorityRestore(running_thread);
     }
 
     /* Check if Thread is waiting for a Mutex */
@@ -247,7 +418,15 @@ static osStatus_t svcMutexRelease(osMutexId_t mutex_id)
       krnThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
       mutex->holder = thread;
       mutex->cnt = 1U;
+      mutex->lock = (uint32_t)thread | MUTEX_LOCK_KERNEL;
       QueueAppend(&thread->mutex_que, &mutex->mutex_que);
+      /* Raise the new owner to the priority ceiling */
+      if ((mutex->attr & osMutexPrioCeiling) != 0U) {
+        krnMutexOwnerPriorityRestore(thread);
+      }
+    }
+    else {
+      mutex->lock = 0U;
     }
 
     SchedDispatch(NULL);
@@ -266,7 +445,8 @@ static osThreadId_t svcMutexGetOwner(osMutexId_t mutex_id)
   }
 
   if (mutex->cnt == 0U) {
-    return (NULL);
+    /* Owner of a mutex locked in thread mode or NULL */
+    return ((osThreadId_t)mutex->lock);
   }
 
   return (mutex->holder);
@@ -281,14 +461,16 @@ static osStatus_t svcMutexDelete(osMutexId_t mutex_id)
     return (osErrorParameter);
   }
 
+  MutexLockTake(mutex);
+
   /* Check if Mutex is locked */
   if (mutex->cnt != 0U) {
     /* Remove Mutex from Thread owner list */
     QueueRemoveEntry(&mutex->mutex_que);
 
     /* Restore owner Thread priority */
-    if ((mutex->attr & osMutexPrioInherit) != 0U) {
-      RestoreThreadPriority(mutex->holder);
+    if ((mutex->attr & (osMutexPrioInherit | osMutexPrioCeiling)) != 0U) {
+      krnMutexOwnerPriorityRestore(mutex->holder);
     }
 
     /* Unblock waiting threads */
@@ -299,6 +481,13 @@ static osStatus_t svcMutexDelete(osMutexId_t mutex_id)
 
   /* Mutex not exists now */
   mutex->id = ID_INVALID;
+  mutex->lock = 0U;
+  krnPostProcessCancel((osObject_t *)mutex);
+
+  /* Free object memory */
+  if ((mutex->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.mutex, mutex);
+  }
 
   return (osOK);
 }
@@ -361,6 +550,9 @@ osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
   if (IsIrqMode() || IsIrqMasked()) {
     status = osErrorISR;
   }
+  else if (MutexFastAcquire(mutex_id)) {
+    status = osOK;
+  }
   else {
     status = (osStatus_t)SVC_2(mutex_id, timeout, svcMutexAcquire);
     if (status == osThreadWait) {
@@ -384,6 +576,9 @@ osStatus_t osMutexRelease(osMutexId_t mutex_id)
   if (IsIrqMode() || IsIrqMasked()) {
     status = osErrorISR;
   }
+  else if (MutexFastRelease(mutex_id)) {
+    status = osOK;
+  }
   else {
     status = (osStatus_t)SVC_1(mutex_id, svcMutexRelease);
   }
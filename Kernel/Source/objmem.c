@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Kernel object memory.
+ *
+ * Objects created without user provided memory take their control block from
+ * the Memory Pool of the object type and, if the pool is not configured or is
+ * exhausted, from the Global Dynamic Memory heap. Thread stacks and data
+ * storage of Memory Pools and Message Queues are allocated the same way.
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include "kernel_lib.h"
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+static void ObjectMemPoolInit(osMemoryPoolInfo_t *mp_info)
+{
+  if (mp_info != NULL) {
+    krnMemoryPoolInit(mp_info->max_blocks, mp_info->block_size, mp_info->block_base, mp_info);
+  }
+}
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Initialize the object memory pools and heap of the kernel configuration.
+ */
+void krnObjectMemInit(void)
+{
+  ObjectMemPoolInit(osConfig.mpi.stack);
+  ObjectMemPoolInit(osConfig.mpi.thread);
+  ObjectMemPoolInit(osConfig.mpi.timer);
+  ObjectMemPoolInit(osConfig.mpi.event_flags);
+  ObjectMemPoolInit(osConfig.mpi.mutex);
+  ObjectMemPoolInit(osConfig.mpi.semaphore);
+  ObjectMemPoolInit(osConfig.mpi.memory_pool);
+  ObjectMemPoolInit(osConfig.mpi.message_queue);
+
+  if (osConfig.heap.cb != NULL) {
+    if (!krnHeapInit(osConfig.heap.cb, osConfig.heap.mem, osConfig.heap.size)) {
+      osConfig.heap.cb->id = ID_INVALID;
+    }
+  }
+}
+
+/**
+ * @brief       Allocate memory for an object, from its type's pool or else from
+ *              the object memory heap.
+ * @param[in]   mp_info   pool of the object type or NULL.
+ * @param[in]   size      size in bytes.
+ * @return      address of the memory or NULL in case of no memory is available.
+ */
+void *krnObjectMemAlloc(osMemoryPoolInfo_t *mp_info, uint32_t size)
+{
+  void *mem = NULL;
+
+  /* Reclaim the memory of threads that deleted themselves */
+  krnThreadFreeExited();
+
+  if ((mp_info != NULL) && (size <= mp_info->block_size)) {
+    mem = krnMemoryPoolAlloc(mp_info);
+  }
+
+  if ((mem == NULL) && (osConfig.heap.cb != NULL) && (osConfig.heap.cb->id == ID_HEAP)) {
+    mem = krnHeapAlloc(osConfig.heap.cb, size);
+  }
+
+  return (mem);
+}
+
+/**
+ * @brief       Return memory allocated by \ref krnObjectMemAlloc.
+ * @param[in]   mp_info   pool of the object type or NULL.
+ * @param[in]   mem       address of the memory.
+ */
+void krnObjectMemFree(osMemoryPoolInfo_t *mp_info, void *mem)
+{
+  if (krnMemoryPoolFree(mp_info, mem) != osOK) {
+    if (osConfig.heap.cb != NULL) {
+      (void)krnHeapFree(osConfig.heap.cb, mem);
+    }
+  }
+}
+
+/* ----------------------------- End of file ---------------------------------*/
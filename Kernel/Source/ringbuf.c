@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Single producer, single consumer ring buffer.
+ *
+ * The producer only writes head and the consumer only writes tail, so data
+ * moves without a service call and without masking interrupts. Both indexes
+ * run freely and are reduced modulo the power of 2 data count on access.
+ * A consumer that finds less data than it needs publishes the level it
+ * waits for in wait_level and blocks. After a write the producer re-reads
+ * the level and requests post ISR processing while it reaches wait_level.
+ * The post processing wakes the consumer only if the level is still reached.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernel_lib.h"
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+static osRingBuffer_t *RingBufferCheck(osRingBufferId_t rb_id)
+{
+  osRingBuffer_t *rb = rb_id;
+
+  if ((rb == NULL) || (rb->id != ID_RING_BUFFER)) {
+    return (NULL);
+  }
+
+  return (rb);
+}
+
+/**
+ * @brief       Copy data into the ring memory starting at an index.
+ * @param[in]   rb        ring buffer object.
+ * @param[in]   index     ring index.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data.
+ */
+static void RingBufferCopyIn(osRingBuffer_t *rb, uint32_t index, const void *data_ptr, uint32_t count)
+{
+  const uint8_t *src = data_ptr;
+  uint32_t       size = count * rb->data_size;
+  uint32_t       offset = (index & (rb->data_count - 1U)) * rb->data_size;
+  uint32_t       span = (rb->data_count * rb->data_size) - offset;
+
+  if (span > size) {
+    span = size;
+  }
+  memcpy(&rb->rb_mem[offset], src, span);
+  memcpy(&rb->rb_mem[0], &src[span], size - span);
+}
+
+/**
+ * @brief       Copy data out of the ring memory starting at an index.
+ * @param[in]   rb        ring buffer object.
+ * @param[in]   index     ring index.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   count     number of data.
+ */
+static void RingBufferCopyOut(osRingBuffer_t *rb, uint32_t index, void *data_ptr, uint32_t count)
+{
+  uint8_t  *dst = data_ptr;
+  uint32_t  size = count * rb->data_size;
+  uint32_t  offset = (index & (rb->data_count - 1U)) * rb->data_size;
+  uint32_t  span = (rb->data_count * rb->data_size) - offset;
+
+  if (span > size) {
+    span = size;
+  }
+  memcpy(dst, &rb->rb_mem[offset], span);
+  memcpy(&dst[span], &rb->rb_mem[0], size - span);
+}
+
+/*******************************************************************************
+ *  Service Calls
+ ******************************************************************************/
+
+static osRingBufferId_t svcRingBufferNew(uint32_t data_count, uint32_t data_size, const osRingBufferAttr_t *attr)
+{
+  osRingBuffer_t *rb;
+
+  /* Check parameters */
+  if ((data_count == 0U) || ((data_count & (data_count - 1U)) != 0U) || (data_size == 0U) ||
+      (attr == NULL) || ((__CLZ(data_count) + __CLZ(data_size)) < 32U)) {
+    return (NULL);
+  }
+
+  rb = attr->cb_mem;
+
+  /* Check parameters */
+  if ((rb == NULL) || (((uint32_t)rb & 3U) != 0U) || (attr->cb_size < sizeof(osRingBuffer_t)) ||
+      (attr->rb_mem == NULL) || (attr->rb_size < (data_count * data_size)) ||
+      (attr->trigger > data_count)) {
+    return (NULL);
+  }
+
+  /* Initialize control block */
+  rb->id         = ID_RING_BUFFER;
+  rb->flags      = 0U;
+  rb->name       = attr->name;
+  rb->data_count = data_count;
+  rb->data_size  = data_size;
+  rb->trigger    = (attr->trigger != 0U) ? attr->trigger : 1U;
+  rb->head       = 0U;
+  rb->tail       = 0U;
+  rb->wait_level = 0U;
+  rb->rb_mem     = attr->rb_mem;
+
+  QueueReset(&rb->wait_queue);
+  QueueReset(&rb->post_queue);
+
+  return (rb);
+}
+
+static const char *svcRingBufferGetName(osRingBufferId_t rb_id)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+
+  /* Check parameters */
+  if (rb == NULL) {
+    return (NULL);
+  }
+
+  return (rb->name);
+}
+
+static osStatus_t svcRingBufferWait(osRingBufferId_t rb_id, uint32_t level, uint32_t timeout)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+
+  /* Check parameters */
+  if (rb == NULL) {
+    return (osErrorParameter);
+  }
+
+  /* Publish the level, then check that the producer has not reached it yet */
+  rb->wait_level = level;
+  __COMPILER_BARRIER();
+  if ((rb->head - rb->tail) >= level) {
+    return (osOK);
+  }
+
+  /* Suspend current Thread */
+  return (krnThreadWaitEnter(ThreadWaitingQueueGet, &rb->wait_queue, timeout));
+}
+
+static osStatus_t svcRingBufferDelete(osRingBufferId_t rb_id)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+
+  /* Check parameters */
+  if (rb == NULL) {
+    return (osErrorParameter);
+  }
+
+  /* Unblock waiting thread */
+  krnThreadWaitDelete(&rb->wait_queue);
+
+  /* Mark object as invalid */
+  rb->id = ID_INVALID;
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  Post ISR processing
+ ******************************************************************************/
+
+/**
+ * @brief       Ring Buffer post ISR processing.
+ * @param[in]   rb  ring buffer object.
+ */
+void krnRingBufferPostProcess(osRingBuffer_t *rb)
+{
+  /* Check if the consumer is waiting for data and the level is reached */
+  if (!isQueueEmpty(&rb->wait_queue) && ((rb->head - rb->tail) >= rb->wait_level)) {
+    /* Wakeup waiting Thread */
+    krnThreadWaitExit(GetThreadByQueue(rb->wait_queue.next), (uint32_t)osOK, DISPATCH_NO);
+  }
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          osRingBufferId_t osRingBufferNew(uint32_t data_count, uint32_t data_size, const osRingBufferAttr_t *attr)
+ * @brief       Create and Initialize a single producer, single consumer Ring Buffer object.
+ * @param[in]   data_count  maximum number of data in the buffer (power of 2).
+ * @param[in]   data_size   data size in bytes.
+ * @param[in]   attr        ring buffer attributes.
+ * @return      ring buffer ID for reference by other functions or NULL in case of error.
+ */
+osRingBufferId_t osRingBufferNew(uint32_t data_count, uint32_t data_size, const osRingBufferAttr_t *attr)
+{
+  osRingBufferId_t rb_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    rb_id = NULL;
+  }
+  else {
+    rb_id = (osRingBufferId_t)SVC_3(data_count, data_size, attr, svcRingBufferNew);
+  }
+
+  return (rb_id);
+}
+
+/**
+ * @fn          const char *osRingBufferGetName(osRingBufferId_t rb_id)
+ * @brief       Get name of a Ring Buffer object.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osRingBufferGetName(osRingBufferId_t rb_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)SVC_1(rb_id, svcRingBufferGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          uint32_t osRingBufferWrite(osRingBufferId_t rb_id, const void *data_ptr, uint32_t count)
+ * @brief       Write up to count Data into a Ring Buffer. Must be called by the producer only.
+ * @param[in]   rb_id     ring buffer ID obtained by \ref osRingBufferNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data written.
+ */
+uint32_t osRingBufferWrite(osRingBufferId_t rb_id, const void *data_ptr, uint32_t count)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+  uint32_t        head;
+  uint32_t        level;
+  uint32_t        wait_level;
+
+  if ((rb == NULL) || (data_ptr == NULL)) {
+    return (0U);
+  }
+
+  head  = rb->head;
+  level = head - rb->tail;
+  if (count > (rb->data_count - level)) {
+    count = rb->data_count - level;
+  }
+
+  if (count != 0U) {
+    RingBufferCopyIn(rb, head, data_ptr, count);
+
+    /* Publish the data, then check if the consumer waits for it */
+    __COMPILER_BARRIER();
+    rb->head = head + count;
+    __COMPILER_BARRIER();
+
+    wait_level = rb->wait_level;
+    if ((wait_level != 0U) && ((rb->head - rb->tail) >= wait_level)) {
+      /* Register post ISR processing */
+      krnPostProcess((osObject_t *)rb);
+    }
+  }
+
+  return (count);
+}
+
+/**
+ * @fn          uint32_t osRingBufferRead(osRingBufferId_t rb_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Read up to count Data from a Ring Buffer, wait for the trigger level
+ *              or timeout if less data is available. Must be called by the consumer only.
+ * @param[in]   rb_id     ring buffer ID obtained by \ref osRingBufferNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data read.
+ */
+uint32_t osRingBufferRead(osRingBufferId_t rb_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+  uint32_t        tail;
+  uint32_t        level;
+  uint32_t        need;
+
+  if ((rb == NULL) || (data_ptr == NULL)) {
+    return (0U);
+  }
+
+  tail  = rb->tail;
+  level = rb->head - tail;
+
+  need = (count < rb->trigger) ? count : rb->trigger;
+  if ((level < need) && (timeout != 0U) && !IsIrqMode() && !IsIrqMasked()) {
+    /* Wait until the producer reaches the level or timeout */
+    (void)SVC_3(rb, need, timeout, svcRingBufferWait);
+    rb->wait_level = 0U;
+    level = rb->head - tail;
+  }
+
+  if (count > level) {
+    count = level;
+  }
+
+  if (count != 0U) {
+    /* Read the data before the slots are given back to the producer */
+    __COMPILER_BARRIER();
+    RingBufferCopyOut(rb, tail, data_ptr, count);
+    __COMPILER_BARRIER();
+    rb->tail = tail + count;
+  }
+
+  return (count);
+}
+
+/**
+ * @fn          uint32_t osRingBufferGetCount(osRingBufferId_t rb_id)
+ * @brief       Get number of Data in a Ring Buffer.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      number of data or 0 in case of an error.
+ */
+uint32_t osRingBufferGetCount(osRingBufferId_t rb_id)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+
+  if (rb == NULL) {
+    return (0U);
+  }
+
+  return (rb->head - rb->tail);
+}
+
+/**
+ * @fn          uint32_t osRingBufferGetSpace(osRingBufferId_t rb_id)
+ * @brief       Get number of free slots for Data in a Ring Buffer.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      number of free slots or 0 in case of an error.
+ */
+uint32_t osRingBufferGetSpace(osRingBufferId_t rb_id)
+{
+  osRingBuffer_t *rb = RingBufferCheck(rb_id);
+
+  if (rb == NULL) {
+    return (0U);
+  }
+
+  return (rb->data_count - (rb->head - rb->tail));
+}
+
+/**
+ * @fn          osStatus_t osRingBufferDelete(osRingBufferId_t rb_id)
+ * @brief       Delete a Ring Buffer object.
+ * @param[in]   rb_id   ring buffer ID obtained by \ref osRingBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osRingBufferDelete(osRingBufferId_t rb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_1(rb_id, svcRingBufferDelete);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
@@ -27,17 +27,66 @@
  *  Scheduler functions
  ******************************************************************************/
 
+__STATIC_FORCEINLINE
+void ReadyBmpSet(uint32_t level)
+{
+#if (NUM_PRIORITY > 32U)
+  osInfo.ready_bmp.group |= (1UL << (level >> 5U));
+  osInfo.ready_bmp.map[level >> 5U] |= (1UL << (level & 31U));
+#else
+  osInfo.ready_bmp.map[0] |= (1UL << level);
+#endif
+}
+
+__STATIC_FORCEINLINE
+void ReadyBmpClear(uint32_t level)
+{
+#if (NUM_PRIORITY > 32U)
+  osInfo.ready_bmp.map[level >> 5U] &= ~(1UL << (level & 31U));
+  if (osInfo.ready_bmp.map[level >> 5U] == 0U) {
+    osInfo.ready_bmp.group &= ~(1UL << (level >> 5U));
+  }
+#else
+  osInfo.ready_bmp.map[0] &= ~(1UL << level);
+#endif
+}
+
+/* EDF threads go first in deadline order, other threads follow in FIFO order */
+__STATIC_FORCEINLINE
+bool DeadlineBefore(osThread_t *thread, osThread_t *other)
+{
+  return ((thread->rel_deadline != 0U) &&
+          ((other->rel_deadline == 0U) || ((int32_t)(thread->deadline - other->deadline) < 0)));
+}
+
+static void ReadyListInsert(queue_t *que, osThread_t *thread)
+{
+  queue_t *entry;
+
+  if (thread->rel_deadline != 0U) {
+    for (entry = que->next; entry != que; entry = entry->next) {
+      if (DeadlineBefore(thread, GetThreadByQueue(entry))) {
+        break;
+      }
+    }
+    QueueAppend(entry, &thread->thread_que);
+  }
+  else {
+    QueueAppend(que, &thread->thread_que);
+  }
+}
+
 static osThread_t* ThreadHighestPrioGet(void)
 {
-  int8_t priority;
+  int32_t priority;
   osThread_t *thread;
 
-  if (osInfo.ready_to_run_bmp == 0U) {
+  priority = SchedReadyPriorityGet();
+  if (priority == (int32_t)osPriorityNone) {
     return (NULL);
   }
 
-  priority = (int8_t)((NUM_PRIORITY - 1U) - __CLZ(osInfo.ready_to_run_bmp));
-  thread = GetThreadByQueue(osInfo.ready_list[priority].next);
+  thread = GetThreadByQueue(osInfo.ready_list[priority - 1].next);
 
   return (thread);
 }
@@ -45,10 +94,44 @@ static osThread_t* ThreadHighestPrioGet(void)
 __STATIC_FORCEINLINE
 void ThreadSwitch(osThread_t *thread)
 {
+  if (osInfo.thread.run.next != thread) {
+    if ((osConfig.flags & osConfigCpuUsage) != 0U) {
+      krnThreadCpuTimeUpdate();
+    }
+    if ((thread->budget != 0U) ||
+        ((osInfo.thread.run.next != NULL) && (osInfo.thread.run.next->budget != 0U))) {
+      krnThreadBudgetSwitch(thread);
+    }
+    TRACE_EVENT(osTraceThreadSwitch, thread, osInfo.thread.run.next);
+  }
+
   thread->state = ThreadRunning;
   osInfo.thread.run.next = thread;
 }
 
+/**
+ * @brief       Get the highest priority of the ready threads.
+ * @return      priority or osPriorityNone if there are no ready threads.
+ */
+int32_t SchedReadyPriorityGet(void)
+{
+  uint32_t word;
+
+#if (NUM_PRIORITY > 32U)
+  if (osInfo.ready_bmp.group == 0U) {
+    return ((int32_t)osPriorityNone);
+  }
+  word = 31U - __CLZ(osInfo.ready_bmp.group);
+#else
+  if (osInfo.ready_bmp.map[0] == 0U) {
+    return ((int32_t)osPriorityNone);
+  }
+  word = 0U;
+#endif
+
+  return ((int32_t)((word << 5U) + (32U - __CLZ(osInfo.ready_bmp.map[word]))));
+}
+
 /**
  * @brief       Dispatch specified Thread or Ready Thread with Highest Priority.
  * @param[in]   thread  thread object or NULL.
@@ -71,7 +154,8 @@ void SchedDispatch(osThread_t *thread)
       return;
     }
 
-    if (thread->priority > thread_next->priority) {
+    if ((thread->priority > thread_next->priority) ||
+        ((thread->priority == thread_next->priority) && DeadlineBefore(thread, thread_next))) {
       /* Preempt running Thread */
       thread_next->state = ThreadReady;
       ThreadSwitch(thread);
@@ -87,35 +171,34 @@ void SchedDispatch(osThread_t *thread)
 void SchedYield(osThread_t *thread)
 {
   queue_t *que;
-  int8_t  priority;
 
-  priority = thread->priority - 1;
-  que = &osInfo.ready_list[priority];
+  que = &osInfo.ready_list[thread->priority - 1];
 
   if (!isQueueEmpty(que) && que->next->next != que) {
     /* Remove the thread from ready queue */
     QueueRemoveEntry(&thread->thread_que);
     thread->state = ThreadReady;
-    /* Add the thread to the end of ready queue */
-    QueueAppend(que, &thread->thread_que);
+    /* Add the thread to the end of ready queue (behind equal deadlines) */
+    ReadyListInsert(que, thread);
   }
 }
 
 /**
- * @brief       Adds thread to the end of ready queue for current priority
+ * @brief       Adds thread to the end of ready queue for current priority,
+ *              threads with a deadline are added in deadline order
  * @param[in]   thread  Thread object
  */
 void SchedThreadReadyAdd(osThread_t *thread)
 {
-  int8_t priority = thread->priority - 1;
+  uint32_t level = (uint32_t)thread->priority - 1U;
 
   /* Remove the thread from any queue */
   QueueRemoveEntry(&thread->thread_que);
 
   thread->state = ThreadReady;
   /* Add the thread to the end of ready queue */
-  QueueAppend(&osInfo.ready_list[priority], &thread->thread_que);
-  osInfo.ready_to_run_bmp |= (1UL << priority);
+  ReadyListInsert(&osInfo.ready_list[level], thread);
+  ReadyBmpSet(level);
 }
 
 /**
@@ -125,14 +208,14 @@ void SchedThreadReadyAdd(osThread_t *thread)
  */
 void SchedThreadReadyDel(osThread_t *thread, uint8_t thread_state)
 {
-  int8_t priority = thread->priority - 1;
+  uint32_t level = (uint32_t)thread->priority - 1U;
 
   /* Remove the thread from ready queue */
   QueueRemoveEntry(&thread->thread_que);
 
   thread->state = thread_state;
-  if (isQueueEmpty(&osInfo.ready_list[priority])) {
+  if (isQueueEmpty(&osInfo.ready_list[level])) {
     /* No ready threads for the current priority */
-    osInfo.ready_to_run_bmp &= ~(1UL << priority);
+    ReadyBmpClear(level);
   }
 }
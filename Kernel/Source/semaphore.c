@@ -89,6 +89,39 @@ static osStatus_t SemaphoreTokenIncrement(osSemaphore_t *sem)
   return (status);
 }
 
+/**
+ * @brief       Try to acquire a Semaphore token without a service call.
+ * @param[in]   sem  semaphore object.
+ * @return      true - token acquired, false - service call is required.
+ */
+__STATIC_FORCEINLINE
+bool SemaphoreFastAcquire(osSemaphore_t *sem)
+{
+  if ((sem == NULL) || (sem->id != ID_SEMAPHORE)) {
+    return (false);
+  }
+
+  return (AtomicDecrementNonZero16(&sem->count));
+}
+
+/**
+ * @brief       Try to release a Semaphore token without a service call.
+ * @param[in]   sem  semaphore object.
+ * @return      true - token released, false - service call is required.
+ */
+__STATIC_FORCEINLINE
+bool SemaphoreFastRelease(osSemaphore_t *sem)
+{
+  if ((sem == NULL) || (sem->id != ID_SEMAPHORE)) {
+    return (false);
+  }
+
+  /* Only while no Thread is waiting for a token */
+  return (AtomicIncrementLimit16(&sem->count, sem->max_count,
+                                 (void *const volatile *)&sem->wait_queue.next,
+                                 &sem->wait_queue));
+}
+
 /*******************************************************************************
  *  function implementations (scope: module-local)
  ******************************************************************************/
@@ -96,25 +129,47 @@ static osStatus_t SemaphoreTokenIncrement(osSemaphore_t *sem)
 static osSemaphoreId_t svcSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
 {
   osSemaphore_t *sem;
+  const char    *name;
+  uint8_t        flags;
 
   /* Check parameters */
-  if ((attr == NULL)                          ||
-      (attr->cb_mem == NULL)                  ||
-      (((uint32_t)attr->cb_mem & 3U) != 0U)   ||
-      (attr->cb_size < sizeof(osSemaphore_t)) ||
-      (max_count == 0U)                       ||
-      (max_count > SemaphoreTokenLimit)       ||
-      (initial_count > max_count))
-  {
+  if ((max_count == 0U) || (max_count > SemaphoreTokenLimit) || (initial_count > max_count)) {
     return (NULL);
   }
 
-  sem = attr->cb_mem;
+  if (attr != NULL) {
+    sem  = attr->cb_mem;
+    name = attr->name;
+
+    /* Check parameters */
+    if (sem != NULL) {
+      if ((((uint32_t)sem & 3U) != 0U) || (attr->cb_size < sizeof(osSemaphore_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    sem  = NULL;
+    name = NULL;
+  }
+
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (sem == NULL) {
+    sem = krnObjectMemAlloc(osConfig.mpi.semaphore, sizeof(osSemaphore_t));
+    if (sem == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
+  }
 
   /* Initialize control block */
   sem->id         = ID_SEMAPHORE;
-  sem->flags      = 0U;
-  sem->name       = attr->name;
+  sem->flags      = flags;
+  sem->name       = name;
   sem->count      = (uint16_t)initial_count;
   sem->max_count  = (uint16_t)max_count;
 
@@ -205,6 +260,12 @@ static osStatus_t svcSemaphoreDelete(osSemaphoreId_t semaphore_id)
   krnThreadWaitDelete(&sem->wait_queue);
   /* Mark object as invalid */
   sem->id = ID_INVALID;
+  krnPostProcessCancel((osObject_t *)sem);
+
+  /* Free object memory */
+  if ((sem->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.semaphore, sem);
+  }
 
   return (osOK);
 }
@@ -335,6 +396,9 @@ osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
   if (IsIrqMode() || IsIrqMasked()) {
     status = isrSemaphoreAcquire(semaphore_id, timeout);
   }
+  else if (SemaphoreFastAcquire(semaphore_id)) {
+    status = osOK;
+  }
   else {
     status = (osStatus_t)SVC_2(semaphore_id, timeout, svcSemaphoreAcquire);
     if (status == osThreadWait) {
@@ -358,6 +422,9 @@ osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
   if (IsIrqMode() || IsIrqMasked()) {
     status = isrSemaphoreRelease(semaphore_id);
   }
+  else if (SemaphoreFastRelease(semaphore_id)) {
+    status = osOK;
+  }
   else {
     status = (osStatus_t)SVC_1(semaphore_id, svcSemaphoreRelease);
   }
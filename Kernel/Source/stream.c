@@ -0,0 +1,765 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: mbOS real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Byte stream buffer.
+ *
+ * Data is copied with interrupts enabled. A writer reserves space by moving
+ * head under the lock, copies and then publishes the bytes in count; a
+ * reader takes bytes by moving tail and frees their space once copied.
+ * Writers and readers that interrupt a copy in progress nest, so the
+ * outermost one publishes the bytes or frees the space for all of them.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernel_lib.h"
+
+/*******************************************************************************
+ *  Helper functions
+ ******************************************************************************/
+
+/**
+ * @brief       Get the number of free bytes in the buffer.
+ * @param[in]   sb  stream buffer object.
+ * @return      number of bytes.
+ */
+__STATIC_INLINE
+uint32_t StreamSpace(osStream_t *sb)
+{
+  return (sb->size - sb->count - sb->put_pending - sb->get_pending);
+}
+
+/**
+ * @brief       Reserve space for up to size bytes.
+ * @param[in]   sb    stream buffer object.
+ * @param[in]   size  pointer to number of bytes, reduced to the reserved bytes.
+ * @return      buffer index of the reserved space.
+ */
+static uint32_t StreamPutReserve(osStream_t *sb, uint32_t *size)
+{
+  uint32_t head;
+
+  BEGIN_CRITICAL_SECTION
+
+  if (*size > StreamSpace(sb)) {
+    *size = StreamSpace(sb);
+  }
+  head = sb->head;
+  sb->head += *size;
+  if (sb->head >= sb->size) {
+    sb->head -= sb->size;
+  }
+  sb->put_pending += *size;
+  sb->put_nest++;
+
+  END_CRITICAL_SECTION
+
+  return (head);
+}
+
+/**
+ * @brief       Publish the reserved bytes, a nested writer leaves them to
+ *              the writer it interrupted.
+ * @param[in]   sb    stream buffer object.
+ */
+static void StreamPutPublish(osStream_t *sb)
+{
+  BEGIN_CRITICAL_SECTION
+
+  sb->put_nest--;
+  if (sb->put_nest == 0U) {
+    sb->count += sb->put_pending;
+    sb->put_pending = 0U;
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Take up to size bytes.
+ * @param[in]   sb    stream buffer object.
+ * @param[in]   size  pointer to number of bytes, reduced to the taken bytes.
+ * @return      buffer index of the taken bytes.
+ */
+static uint32_t StreamGetTake(osStream_t *sb, uint32_t *size)
+{
+  uint32_t tail;
+
+  BEGIN_CRITICAL_SECTION
+
+  if (*size > sb->count) {
+    *size = sb->count;
+  }
+  tail = sb->tail;
+  sb->tail += *size;
+  if (sb->tail >= sb->size) {
+    sb->tail -= sb->size;
+  }
+  sb->count -= *size;
+  sb->get_pending += *size;
+  sb->get_nest++;
+
+  END_CRITICAL_SECTION
+
+  return (tail);
+}
+
+/**
+ * @brief       Free the space of the taken bytes, a nested reader leaves it
+ *              to the reader it interrupted.
+ * @param[in]   sb    stream buffer object.
+ */
+static void StreamGetRelease(osStream_t *sb)
+{
+  BEGIN_CRITICAL_SECTION
+
+  sb->get_nest--;
+  if (sb->get_nest == 0U) {
+    sb->get_pending = 0U;
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Copy up to size bytes into the buffer.
+ * @param[in]   sb        stream buffer object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   size      number of bytes.
+ * @return      number of bytes copied.
+ */
+static uint32_t StreamPut(osStream_t *sb, const void *data_ptr, uint32_t size)
+{
+  const uint8_t *src = data_ptr;
+  uint32_t       head;
+  uint32_t       span;
+
+  head = StreamPutReserve(sb, &size);
+
+  if (size != 0U) {
+    /* Copy up to the end of the buffer, then from its start */
+    span = sb->size - head;
+    if (span > size) {
+      span = size;
+    }
+    memcpy(&sb->sb_mem[head], src, span);
+    memcpy(&sb->sb_mem[0], &src[span], size - span);
+  }
+
+  StreamPutPublish(sb);
+
+  return (size);
+}
+
+/**
+ * @brief       Copy up to size bytes out of the buffer.
+ * @param[in]   sb        stream buffer object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   size      number of bytes the buffer can hold.
+ * @return      number of bytes copied.
+ */
+static uint32_t StreamGet(osStream_t *sb, void *data_ptr, uint32_t size)
+{
+  uint8_t  *dst = data_ptr;
+  uint32_t  tail;
+  uint32_t  span;
+
+  tail = StreamGetTake(sb, &size);
+
+  if (size != 0U) {
+    /* Copy up to the end of the buffer, then from its start */
+    span = sb->size - tail;
+    if (span > size) {
+      span = size;
+    }
+    memcpy(dst, &sb->sb_mem[tail], span);
+    memcpy(&dst[span], &sb->sb_mem[0], size - span);
+  }
+
+  StreamGetRelease(sb);
+
+  return (size);
+}
+
+static void StreamReset(osStream_t *sb)
+{
+  BEGIN_CRITICAL_SECTION
+
+  /* Discard the published data only, copies in progress keep their space */
+  sb->tail += sb->count;
+  if (sb->tail >= sb->size) {
+    sb->tail -= sb->size;
+  }
+  sb->count = 0U;
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Get the number of bytes a read of size bytes waits for.
+ * @param[in]   sb    stream buffer object.
+ * @param[in]   size  number of bytes the reader can hold.
+ * @return      number of bytes.
+ */
+__STATIC_INLINE
+uint32_t StreamReadLevel(osStream_t *sb, uint32_t size)
+{
+  return ((size < sb->trigger) ? size : sb->trigger);
+}
+
+/**
+ * @brief       Pass data to Threads waiting to read.
+ * @param[in]   sb  stream buffer object.
+ * @return      true if a Thread was woken up.
+ */
+static bool StreamWakeRead(osStream_t *sb)
+{
+  osThread_t     *thread;
+  winfo_stream_t *winfo;
+  bool            woken = false;
+
+  while (!isQueueEmpty(&sb->wait_read_queue)) {
+    thread = GetThreadByQueue(sb->wait_read_queue.next);
+    winfo = &thread->winfo.stream;
+    if (sb->count < StreamReadLevel(sb, winfo->size)) {
+      break;
+    }
+    krnThreadWaitExit(thread, StreamGet(sb, (void *)winfo->data_ptr, winfo->size), DISPATCH_NO);
+    woken = true;
+  }
+
+  return (woken);
+}
+
+/**
+ * @brief       Take data from Threads waiting to write.
+ * @param[in]   sb  stream buffer object.
+ * @return      true if any data was taken.
+ */
+static bool StreamWakeWrite(osStream_t *sb)
+{
+  osThread_t     *thread;
+  winfo_stream_t *winfo;
+  uint32_t        size;
+  bool            moved = false;
+
+  while (!isQueueEmpty(&sb->wait_write_queue)) {
+    thread = GetThreadByQueue(sb->wait_write_queue.next);
+    winfo = &thread->winfo.stream;
+    size = StreamPut(sb, (const void *)winfo->data_ptr, winfo->size);
+    if (size == 0U) {
+      break;
+    }
+    winfo->data_ptr += size;
+    winfo->size     -= size;
+    winfo->done     += size;
+    moved = true;
+    if (winfo->size != 0U) {
+      /* The writer keeps its place until all its bytes are written */
+      break;
+    }
+    krnThreadWaitExit(thread, winfo->done, DISPATCH_NO);
+  }
+
+  return (moved);
+}
+
+/**
+ * @brief       Move data between waiting writers and readers until neither
+ *              can make progress.
+ * @param[in]   sb  stream buffer object.
+ * @return      true if any waiting Thread was served.
+ */
+static bool StreamWake(osStream_t *sb)
+{
+  bool progress;
+  bool served = false;
+
+  do {
+    progress = StreamWakeRead(sb);
+    if (StreamWakeWrite(sb)) {
+      progress = true;
+    }
+    served = served || progress;
+  } while (progress);
+
+  return (served);
+}
+
+/*******************************************************************************
+ *  Service Calls
+ ******************************************************************************/
+
+static osStreamId_t svcStreamNew(uint32_t size, const osStreamAttr_t *attr)
+{
+  osStream_t *sb;
+
+  /* Check parameters */
+  if ((size == 0U) || (attr == NULL)) {
+    return (NULL);
+  }
+
+  sb = attr->cb_mem;
+
+  /* Check parameters */
+  if ((sb == NULL) || (((uint32_t)sb & 3U) != 0U) || (attr->cb_size < sizeof(osStream_t)) ||
+      (attr->sb_mem == NULL) || (attr->sb_size < size) || (attr->trigger > size)) {
+    return (NULL);
+  }
+
+  /* Initialize control block */
+  sb->id      = ID_STREAM;
+  sb->flags   = 0U;
+  sb->name    = attr->name;
+  sb->size    = size;
+  sb->count   = 0U;
+  sb->trigger = (attr->trigger != 0U) ? attr->trigger : 1U;
+  sb->head    = 0U;
+  sb->tail    = 0U;
+  sb->sb_mem  = attr->sb_mem;
+
+  sb->put_pending = 0U;
+  sb->get_pending = 0U;
+  sb->put_nest    = 0U;
+  sb->get_nest    = 0U;
+
+  QueueReset(&sb->wait_write_queue);
+  QueueReset(&sb->wait_read_queue);
+  QueueReset(&sb->post_queue);
+
+  return (sb);
+}
+
+static const char *svcStreamGetName(osStreamId_t sb_id)
+{
+  osStream_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM)) {
+    return (NULL);
+  }
+
+  return (sb->name);
+}
+
+static uint32_t svcStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStream_t     *sb = sb_id;
+  winfo_stream_t *winfo;
+  uint32_t        done;
+  uint32_t        num;
+  osStatus_t      status;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM) || (data_ptr == NULL) || (size == 0U)) {
+    return (0U);
+  }
+
+  /* Bytes of waiting writers go first */
+  if (isQueueEmpty(&sb->wait_write_queue)) {
+    done = StreamPut(sb, data_ptr, size);
+    if ((done != 0U) && StreamWakeRead(sb)) {
+      /* Woken readers made room for the rest */
+      while (done != size) {
+        num = StreamPut(sb, (const uint8_t *)data_ptr + done, size - done);
+        if (num == 0U) {
+          break;
+        }
+        done += num;
+        (void)StreamWakeRead(sb);
+      }
+      SchedDispatch(NULL);
+    }
+  }
+  else {
+    done = 0U;
+  }
+
+  if ((done != size) && (timeout != 0U)) {
+    /* Suspend current Thread */
+    status = krnThreadWaitEnter(ThreadWaitingQueuePut, &sb->wait_write_queue, timeout);
+    if (status != osErrorTimeout) {
+      winfo           = &ThreadGetRunning()->winfo.stream;
+      winfo->data_ptr = (uint32_t)data_ptr + done;
+      winfo->size     = size - done;
+      winfo->done     = done;
+      done            = (uint32_t)status;
+    }
+  }
+
+  return (done);
+}
+
+static uint32_t svcStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStream_t     *sb = sb_id;
+  winfo_stream_t *winfo;
+  uint32_t        done;
+  osStatus_t      status;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM) || (data_ptr == NULL) || (size == 0U)) {
+    return (0U);
+  }
+
+  if ((timeout != 0U) && (sb->count < StreamReadLevel(sb, size))) {
+    /* Suspend current Thread */
+    status = krnThreadWaitEnter(ThreadWaitingQueueGet, &sb->wait_read_queue, timeout);
+    if (status != osErrorTimeout) {
+      winfo           = &ThreadGetRunning()->winfo.stream;
+      winfo->data_ptr = (uint32_t)data_ptr;
+      winfo->size     = size;
+      done            = (uint32_t)status;
+    }
+    else {
+      done = StreamGet(sb, data_ptr, size);
+    }
+  }
+  else {
+    done = StreamGet(sb, data_ptr, size);
+    /* Check if Threads are waiting to write */
+    if ((done != 0U) && StreamWake(sb)) {
+      SchedDispatch(NULL);
+    }
+  }
+
+  return (done);
+}
+
+static uint32_t svcStreamGetCount(osStreamId_t sb_id)
+{
+  osStream_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM)) {
+    return (0U);
+  }
+
+  return (sb->count);
+}
+
+static uint32_t svcStreamGetSpace(osStreamId_t sb_id)
+{
+  osStream_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM)) {
+    return (0U);
+  }
+
+  return (StreamSpace(sb));
+}
+
+static osStatus_t svcStreamReset(osStreamId_t sb_id)
+{
+  osStream_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM)) {
+    return (osErrorParameter);
+  }
+
+  /* Remove data from the buffer */
+  StreamReset(sb);
+  /* Check if Threads are waiting to write */
+  if (StreamWake(sb)) {
+    SchedDispatch(NULL);
+  }
+
+  return (osOK);
+}
+
+static osStatus_t svcStreamDelete(osStreamId_t sb_id)
+{
+  osStream_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM)) {
+    return (osErrorParameter);
+  }
+
+  /* Unblock waiting threads */
+  krnThreadWaitDelete(&sb->wait_write_queue);
+  krnThreadWaitDelete(&sb->wait_read_queue);
+
+  /* Mark object as invalid */
+  sb->id = ID_INVALID;
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  ISR Calls
+ ******************************************************************************/
+
+__STATIC_INLINE
+uint32_t isrStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStream_t *sb = sb_id;
+  uint32_t    done;
+
+  /* Check parameters */
+  if ((sb       == NULL) || (sb->id != ID_STREAM) || (data_ptr == NULL) ||
+      (size     == 0U)   || (timeout != 0U)) {
+    return (0U);
+  }
+
+  /* Try to put data into the buffer */
+  done = StreamPut(sb, data_ptr, size);
+  if ((done != 0U) && !isQueueEmpty(&sb->wait_read_queue)) {
+    /* Register post ISR processing */
+    krnPostProcess((osObject_t *)sb);
+  }
+
+  return (done);
+}
+
+__STATIC_INLINE
+uint32_t isrStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStream_t *sb = sb_id;
+  uint32_t    done;
+
+  /* Check parameters */
+  if ((sb       == NULL) || (sb->id != ID_STREAM) || (data_ptr == NULL) ||
+      (size     == 0U)   || (timeout != 0U)) {
+    return (0U);
+  }
+
+  /* Get data from the buffer */
+  done = StreamGet(sb, data_ptr, size);
+  if ((done != 0U) && !isQueueEmpty(&sb->wait_write_queue)) {
+    /* Register post ISR processing */
+    krnPostProcess((osObject_t *)sb);
+  }
+
+  return (done);
+}
+
+/*******************************************************************************
+ *  Post ISR processing
+ ******************************************************************************/
+
+/**
+ * @brief       Stream Buffer post ISR processing.
+ * @param[in]   sb  stream buffer object.
+ */
+void krnStreamPostProcess(osStream_t *sb)
+{
+  /* Check if Threads are waiting to read or write */
+  (void)StreamWake(sb);
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          osStreamId_t osStreamNew(uint32_t size, const osStreamAttr_t *attr)
+ * @brief       Create and Initialize a Stream Buffer object.
+ * @param[in]   size    buffer size in bytes.
+ * @param[in]   attr    stream buffer attributes.
+ * @return      stream buffer ID for reference by other functions or NULL in case of error.
+ */
+osStreamId_t osStreamNew(uint32_t size, const osStreamAttr_t *attr)
+{
+  osStreamId_t sb_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    sb_id = NULL;
+  }
+  else {
+    sb_id = (osStreamId_t)SVC_2(size, attr, svcStreamNew);
+  }
+
+  return (sb_id);
+}
+
+/**
+ * @fn          const char *osStreamGetName(osStreamId_t sb_id)
+ * @brief       Get name of a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osStreamGetName(osStreamId_t sb_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)SVC_1(sb_id, svcStreamGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          uint32_t osStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Write bytes into a Stream Buffer, wait until all bytes are written or timeout.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   size      number of bytes to write.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes written.
+ */
+uint32_t osStreamWrite(osStreamId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  uint32_t done;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    done = isrStreamWrite(sb_id, data_ptr, size, timeout);
+  }
+  else {
+    done = SVC_4(sb_id, data_ptr, size, timeout, svcStreamWrite);
+    if ((int32_t)done == osThreadWait) {
+      done = ThreadGetRunning()->winfo.ret_val;
+      if ((int32_t)done < 0) {
+        /* Timeout or deleted: report the bytes written so far */
+        done = ThreadGetRunning()->winfo.stream.done;
+      }
+    }
+  }
+
+  return (done);
+}
+
+/**
+ * @fn          uint32_t osStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Read up to size bytes from a Stream Buffer, wait for the trigger level
+ *              or timeout if less data is available.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   size      number of bytes the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes read.
+ */
+uint32_t osStreamRead(osStreamId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  uint32_t done;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    done = isrStreamRead(sb_id, data_ptr, size, timeout);
+  }
+  else {
+    done = SVC_4(sb_id, data_ptr, size, timeout, svcStreamRead);
+    if ((int32_t)done == osThreadWait) {
+      done = ThreadGetRunning()->winfo.ret_val;
+      if ((int32_t)done == osErrorTimeout) {
+        /* Take what has arrived below the trigger level */
+        done = SVC_4(sb_id, data_ptr, size, 0U, svcStreamRead);
+      }
+      else if ((int32_t)done < 0) {
+        done = 0U;
+      }
+    }
+  }
+
+  return (done);
+}
+
+/**
+ * @fn          uint32_t osStreamGetCount(osStreamId_t sb_id)
+ * @brief       Get number of bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      number of bytes or 0 in case of an error.
+ */
+uint32_t osStreamGetCount(osStreamId_t sb_id)
+{
+  uint32_t count;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    count = svcStreamGetCount(sb_id);
+  }
+  else {
+    count = SVC_1(sb_id, svcStreamGetCount);
+  }
+
+  return (count);
+}
+
+/**
+ * @fn          uint32_t osStreamGetSpace(osStreamId_t sb_id)
+ * @brief       Get number of free bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      number of free bytes or 0 in case of an error.
+ */
+uint32_t osStreamGetSpace(osStreamId_t sb_id)
+{
+  uint32_t space;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    space = svcStreamGetSpace(sb_id);
+  }
+  else {
+    space = SVC_1(sb_id, svcStreamGetSpace);
+  }
+
+  return (space);
+}
+
+/**
+ * @fn          osStatus_t osStreamReset(osStreamId_t sb_id)
+ * @brief       Reset a Stream Buffer to initial empty state.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamReset(osStreamId_t sb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_1(sb_id, svcStreamReset);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osStreamDelete(osStreamId_t sb_id)
+ * @brief       Delete a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamDelete(osStreamId_t sb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_1(sb_id, svcStreamDelete);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
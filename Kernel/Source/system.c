@@ -31,6 +31,24 @@
 #include "Kernel/tick.h"
 #include "kernel_lib.h"
 
+#if (OS_TRACE != 0)
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/* Trace buffer image */
+typedef struct TraceBuffer_s {
+  osTraceHeader_t                       header;
+  osTraceRecord_t        record[OS_TRACE_SIZE];
+} TraceBuffer_t;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static TraceBuffer_t trace_buffer;
+#endif
+
 /*******************************************************************************
  *  Helper functions
  ******************************************************************************/
@@ -84,48 +102,78 @@ static osObject_t* post_queue_get(void)
  *  function implementations (scope: module-exported)
  ******************************************************************************/
 
+/**
+ * @brief       Process expired Timers and Thread Delays.
+ * @return      true - a thread was made ready, false - otherwise.
+ */
+bool krnTimeoutProcess(void)
+{
+  queue_t *que;
+  bool     dispatch = false;
+
+  /* Process Timers */
+  if (krnWheelProcess(&osInfo.timer)) {
+    osThreadFlagsSet(osInfo.thread.timer, FLAGS_TIMER_PROC);
+  }
+
+  /* Process Thread Delays */
+  if (krnWheelProcess(&osInfo.delay)) {
+    que = &osInfo.delay.expired;
+    while (!isQueueEmpty(que)) {
+      krnThreadWaitExit(GetThreadByDelayQueue(que->next), (uint32_t)osErrorTimeout, DISPATCH_NO);
+    }
+    dispatch = true;
+  }
+
+  return (dispatch);
+}
+
+/**
+ * @brief       Get the RTOS kernel system timer count.
+ * @return      RTOS kernel current system timer count as 32-bit value.
+ */
+uint32_t krnSysTimerGetCount(void)
+{
+  uint32_t tick;
+  uint32_t count;
+
+  tick  = osInfo.kernel.tick;
+  count = osTickGetCount();
+  if (osTickGetOverflow() != 0U) {
+    count = osTickGetCount();
+    tick++;
+  }
+  count += tick * osTickGetInterval();
+
+  return (count);
+}
+
 /**
  * @fn          void osTick_Handler(void)
  * @brief       Tick Handler.
  */
 void osTick_Handler(void)
 {
-  osTimer_t  *timer;
   osThread_t *thread;
-  queue_t    *que;
-  bool        dispatch = false;
+  bool        dispatch;
 
   osTickAcknowledgeIRQ();
   ++osInfo.kernel.tick;
+  TRACE_EVENT(osTraceTick, 0U, osInfo.kernel.tick);
 
-  /* Process Timers */
-  que = &osInfo.timer_queue;
-  if (!isQueueEmpty(que)) {
-    timer = GetTimerByQueue(que->next);
-    if (time_before_eq(timer->time, osInfo.kernel.tick)) {
-      osThreadFlagsSet(osInfo.thread.timer, FLAGS_TIMER_PROC);
-    }
-  }
+  dispatch = krnTimeoutProcess();
 
-  /* Process Thread Delays */
-  que = &osInfo.delay_queue;
-  while (!isQueueEmpty(que)) {
-    thread = GetThreadByDelayQueue(que->next);
-    if (time_after(thread->delay, osInfo.kernel.tick)) {
-      break;
-    }
-    else {
-      krnThreadWaitExit(thread, (uint32_t)osErrorTimeout, DISPATCH_NO);
-      dispatch = true;
-    }
+  /* Check CPU budgets */
+  if (krnThreadBudgetProcess()) {
+    dispatch = true;
   }
 
   /* Check Round Robin timeout */
-  if (osConfig.robin_timeout != 0U) {
-    thread = ThreadGetRunning();
-    thread->time_slice++;
-    if (thread->time_slice > osConfig.robin_timeout) {
-      thread->time_slice = 0U;
+  thread = ThreadGetRunning();
+  if ((thread != NULL) && (thread->quantum != 0U)) {
+    thread->slice_count++;
+    if (thread->slice_count > thread->quantum) {
+      thread->slice_count = 0U;
       SchedYield(thread);
       dispatch = true;
     }
@@ -150,6 +198,8 @@ void osPendSV_Handler(void)
       break;
     }
 
+    TRACE_EVENT(osTracePostProcess | ((uint32_t)object->id << 8), object, 0U);
+
     switch (object->id) {
       case ID_THREAD:
         krnThreadFlagsPostProcess(object);
@@ -175,6 +225,18 @@ void osPendSV_Handler(void)
         krnDataQueuePostProcess((osDataQueue_t *)object);
         break;
 
+      case ID_RING_BUFFER:
+        krnRingBufferPostProcess((osRingBuffer_t *)object);
+        break;
+
+      case ID_STREAM:
+        krnStreamPostProcess((osStream_t *)object);
+        break;
+
+      case ID_HEAP:
+        krnHeapPostProcess((osHeap_t *)object);
+        break;
+
       default:
         break;
     }
@@ -192,3 +254,124 @@ void krnPostProcess(osObject_t *object)
   post_queue_put(object);
   PendServCallReq();
 }
+
+/**
+ * @brief       Cancel pending post ISR processing of an object that is deleted.
+ * @param[in]   object  generic object.
+ */
+void krnPostProcessCancel(osObject_t *object)
+{
+  BEGIN_CRITICAL_SECTION
+
+  if ((object->flags & FLAGS_POST_PROC) != 0U) {
+    object->flags &= ~FLAGS_POST_PROC;
+    QueueRemoveEntry(&object->post_queue);
+  }
+
+  END_CRITICAL_SECTION
+}
+
+#if (OS_TRACE != 0)
+/**
+ * @brief       Reset the trace buffer.
+ */
+void krnTraceInit(void)
+{
+  trace_buffer.header.magic = osTraceMagic;
+  trace_buffer.header.size  = OS_TRACE_SIZE;
+  trace_buffer.header.count = 0U;
+  trace_buffer.header.freq  = osTickGetClock();
+}
+
+/**
+ * @brief       Record a kernel event.
+ * @param[in]   event   event code and detail.
+ * @param[in]   object  object address.
+ * @param[in]   arg     event argument.
+ */
+void krnTraceEvent(uint32_t event, uint32_t object, uint32_t arg)
+{
+  osTraceRecord_t *record;
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) || \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) || \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)) || \
+       (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  uint32_t count;
+  uint32_t tick;
+  uint32_t time;
+
+  /* The time stamp is read and the record is reserved without masking the
+     interrupts. An event of a preempting context may therefore take a later
+     record with an earlier time stamp. */
+  do {
+    tick = osInfo.kernel.tick;
+    __COMPILER_BARRIER();
+    time = krnSysTimerGetCount();
+    __COMPILER_BARRIER();
+  } while (tick != osInfo.kernel.tick);
+
+  do {
+    count = trace_buffer.header.count;
+  } while (!AtomicCompareSwap(&trace_buffer.header.count, count, count + 1U));
+
+  record = &trace_buffer.record[count & (OS_TRACE_SIZE - 1U)];
+  record->time   = time;
+  record->event  = event;
+  record->object = object;
+  record->arg    = arg;
+#else
+  /* The record is reserved and written with interrupts masked, so the
+     events of all contexts are in the order of their time stamps */
+  BEGIN_CRITICAL_SECTION
+
+  record = &trace_buffer.record[trace_buffer.header.count & (OS_TRACE_SIZE - 1U)];
+  trace_buffer.header.count++;
+  record->time   = krnSysTimerGetCount();
+  record->event  = event;
+  record->object = object;
+  record->arg    = arg;
+
+  END_CRITICAL_SECTION
+#endif
+}
+
+/**
+ * @brief       Record the return from a Service Call.
+ * @param[in]   func     service function.
+ * @param[in]   ret_val  return value of the service function.
+ * @return      ret_val.
+ */
+uint32_t krnTraceServiceExit(uint32_t func, uint32_t ret_val)
+{
+  krnTraceEvent(osTraceServiceExit, func, ret_val);
+
+  return (ret_val);
+}
+#endif
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          const void *osTraceGetBuffer(uint32_t*)
+ * @brief       Get the trace buffer image.
+ * @param[out]  size  size of the buffer image in bytes.
+ * @return      trace buffer or NULL if the kernel is built without tracing.
+ */
+const void *osTraceGetBuffer(uint32_t *size)
+{
+#if (OS_TRACE != 0)
+  if (size != NULL) {
+    *size = (uint32_t)sizeof(trace_buffer);
+  }
+
+  return (&trace_buffer);
+#else
+  if (size != NULL) {
+    *size = 0U;
+  }
+
+  return (NULL);
+#endif
+}
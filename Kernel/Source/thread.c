@@ -28,6 +28,7 @@
  *  includes
  ******************************************************************************/
 
+#include "Kernel/tick.h"
 #include "kernel_lib.h"
 
 /*******************************************************************************
@@ -37,6 +38,21 @@
 #define osThreadFlagsLimit    31U    ///< number of Thread Flags available per object
 #define osThreadFlagsMask     ((1UL << osThreadFlagsLimit) - 1UL)
 
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+/* Attributes of threads created without attributes */
+static const osThreadAttr_t thread_attr_default = {
+  .priority   = osPriorityNormal,
+  .time_slice = osThreadTimeSliceDefault,
+};
+
+#ifdef WaitForInterrupt
+/* Tickless idle time not yet reported to the kernel [timer counts * tick frequency] */
+static uint32_t idle_remainder;
+#endif
+
 /*******************************************************************************
  *  Helper functions
  ******************************************************************************/
@@ -87,6 +103,126 @@ static uint32_t ThreadFlagsCheck(osThread_t *thread, uint32_t flags, uint32_t op
   return (pattern);
 }
 
+/**
+ * @brief       Get the round-robin quantum of a time slice.
+ * @param[in]   time_slice  time slice in ticks, see \ref osThreadSetTimeSlice.
+ * @return      quantum in ticks, 0 - run until blocked.
+ */
+static uint32_t ThreadQuantum(uint32_t time_slice)
+{
+  if (time_slice == osThreadTimeSliceDefault) {
+    return (osConfig.robin_timeout);
+  }
+
+  return (time_slice);
+}
+
+/**
+ * @brief       Get the current CPU usage window. Windows are one second long
+ *              and start at whole seconds of the kernel tick.
+ * @param[in]   count     system timer count.
+ * @param[out]  elapsed   time elapsed since the start of the window [system timer counts].
+ * @return      index of the window.
+ */
+static uint32_t CpuWindowGet(uint32_t count, uint32_t *elapsed)
+{
+  uint32_t idx = osInfo.kernel.tick / osConfig.tick_freq;
+
+  *elapsed = count - (idx * osConfig.tick_freq * osTickGetInterval());
+
+  return (idx);
+}
+
+/**
+ * @brief       Move the CPU usage windows of a thread to the current window.
+ * @param[in]   thread  thread object.
+ * @param[in]   idx     index of the current window.
+ */
+static void ThreadCpuWindowRoll(osThread_t *thread, uint32_t idx)
+{
+  if (thread->cpu_window_idx != idx) {
+    if ((thread->cpu_window_idx + 1U) == idx) {
+      thread->cpu_prev = thread->cpu_window;
+    }
+    else {
+      thread->cpu_prev = 0U;
+    }
+    thread->cpu_window     = 0U;
+    thread->cpu_window_idx = idx;
+  }
+}
+
+#ifdef WaitForInterrupt
+/**
+ * @brief       OS Tick timer counts elapsed since the timer was set up.
+ */
+static uint32_t IdleTickCount(void)
+{
+  uint32_t count = osTickGetCount();
+
+  if (osTickGetOverflow() != 0U) {
+    count = osTickGetCount() + osTickGetInterval();
+  }
+
+  return (count);
+}
+
+/**
+ * @brief       Sleep with the OS Tick timer reprogrammed to the next timeout.
+ * @param[in]   ticks   number of ticks until the next timeout.
+ * @return      number of ticks elapsed during sleep.
+ */
+static uint32_t IdleSleep(uint32_t ticks)
+{
+  uint32_t tick_freq = osConfig.tick_freq;
+  uint32_t clock;
+  uint32_t freq;
+  uint64_t total;
+  uint32_t elapsed = 0U;
+
+  /* Lowest OS Tick frequency with the period not exceeding the timeout */
+  if (ticks >= tick_freq) {
+    freq = 1U;
+  }
+  else {
+    freq = (tick_freq + ticks - 1U) / ticks;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Do not sleep if a thread became ready after the kernel was suspended */
+  if (SchedReadyPriorityGet() <= (int32_t)osPriorityIdle) {
+    /* Part of the tick period elapsed before the kernel was suspended */
+    total = IdleTickCount();
+
+    /* The OS Tick timer period may be limited by hardware */
+    while ((freq < tick_freq) && (osTickSetup(freq, OS_TICK_HANDLER) != 0)) {
+      freq <<= 1U;
+    }
+
+    if (freq < tick_freq) {
+      osTickEnable();
+      WaitForInterrupt();
+      total += IdleTickCount();
+      osTickDisable();
+
+      /* Time not reported as whole ticks is carried over to the next sleep */
+      clock   = osTickGetClock();
+      total   = (total * tick_freq) + idle_remainder;
+      elapsed = (uint32_t)(total / clock);
+      idle_remainder = (uint32_t)(total % clock);
+
+      /* Restore OS Tick timer */
+      (void)osTickSetup(tick_freq, OS_TICK_HANDLER);
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (elapsed);
+}
+#endif
+
 /**
  * @brief       OS Idle Thread.
  * @param[in]   argument
@@ -95,6 +231,66 @@ __WEAK
 void osIdleThread(void *argument)
 {
   (void) argument;
+
+#ifdef WaitForInterrupt
+  uint32_t ticks;
+
+  if ((osConfig.flags & osConfigTicklessIdle) != 0U) {
+    for (;;) {
+      ticks = osKernelSuspend();
+      if (ticks > 1U) {
+        ticks = IdleSleep(ticks);
+      }
+      else {
+        ticks = 0U;
+      }
+      osKernelResume(ticks);
+
+      /* Not slept: too short to reprogram the OS Tick timer or woken early */
+      if (ticks == 0U) {
+        WaitForInterrupt();
+      }
+    }
+  }
+#endif
+}
+
+/**
+ * @brief       Free the stack and object memory of a deleted thread.
+ * @param[in]   thread  thread object.
+ */
+static void ThreadMemFree(osThread_t *thread)
+{
+  if ((thread->flags & FLAGS_DATA_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.stack, thread->stk_mem);
+  }
+  if ((thread->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.thread, thread);
+  }
+}
+
+/**
+ * @brief       Release the resources of a deleted thread.
+ * @param[in]   thread  thread object.
+ */
+static void ThreadFree(osThread_t *thread)
+{
+  krnPostProcessCancel((osObject_t *)&thread->id);
+
+  /* Reclaim threads that deleted themselves before */
+  krnThreadFreeExited();
+
+  if (osInfo.thread.run.curr == thread) {
+    /* The context of a deleted running thread is not saved. The service
+       call still runs on its stack, so the memory is freed later. */
+    osInfo.thread.run.curr = NULL;
+    if ((thread->flags & (FLAGS_DATA_MEM | FLAGS_OBJECT_MEM)) != 0U) {
+      QueueAppend(&osInfo.thread.exited, &thread->thread_que);
+    }
+    return;
+  }
+
+  ThreadMemFree(thread);
 }
 
 /*******************************************************************************
@@ -103,63 +299,127 @@ void osIdleThread(void *argument)
 
 static osThreadId_t svcThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
 {
-  osThread_t   *thread;
-  void         *stack_mem;
-  uint32_t      stack_size;
-  osPriority_t  priority;
-
-  if ((func == NULL) || (attr == NULL)) {
+  osThread_t         *thread;
+  void               *stack_mem;
+  uint32_t            stack_size;
+  osPriority_t        priority;
+  osMemoryPoolInfo_t *stack_mpi;
+  uint8_t             flags;
+
+  if (func == NULL) {
     return (NULL);
   }
 
+  if (attr == NULL) {
+    attr = &thread_attr_default;
+  }
+
   thread     = attr->cb_mem;
   stack_mem  = attr->stack_mem;
   stack_size = attr->stack_size;
   priority   = attr->priority;
+  stack_mpi  = NULL;
 
-  if ((thread == NULL) || (attr->cb_size < sizeof(osThread_t))) {
+  if (thread != NULL) {
+    if (attr->cb_size < sizeof(osThread_t)) {
+      return (NULL);
+    }
+  }
+  else if (attr->cb_size != 0U) {
     return (NULL);
   }
 
-  if ((stack_mem == NULL)                ||
-      (((uint32_t)stack_mem & 7U) != 0U) ||
-      (stack_size < MIN_THREAD_STK_SIZE) ||
-      ((stack_size & 7U) != 0U))
-  {
-    return (NULL);
+  if (stack_mem != NULL) {
+    if ((((uint32_t)stack_mem & 7U) != 0U) ||
+        (stack_size < MIN_THREAD_STK_SIZE) ||
+        ((stack_size & 7U) != 0U))
+    {
+      return (NULL);
+    }
+  }
+  else {
+    /* Threads without a stack size get a stack from the default stack pool */
+    if (stack_size == 0U) {
+      stack_size = osConfig.thread_stack_size;
+      stack_mpi  = osConfig.mpi.stack;
+    }
+    stack_size = (stack_size + 7U) & ~7U;
+    if (stack_size < MIN_THREAD_STK_SIZE) {
+      return (NULL);
+    }
   }
 
   if (priority == osPriorityNone) {
     priority = osPriorityNormal;
   }
-  else if ((priority < osPriorityIdle) || priority > osPriorityISR) {
+  else if (!IsPriorityValid(priority)) {
     return (NULL);
   }
 
+  if ((attr->deadline > 0x7FFFFFFFU) || (attr->period > 0x7FFFFFFFU)) {
+    return (NULL);
+  }
+
+  /* Allocate object and stack memory if not provided */
+  flags = 0U;
+  if (thread == NULL) {
+    thread = krnObjectMemAlloc(osConfig.mpi.thread, sizeof(osThread_t));
+    if (thread == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
+  }
+  if (stack_mem == NULL) {
+    stack_mem = krnObjectMemAlloc(stack_mpi, stack_size);
+    if (stack_mem == NULL) {
+      if ((flags & FLAGS_OBJECT_MEM) != 0U) {
+        krnObjectMemFree(osConfig.mpi.thread, thread);
+      }
+      return (NULL);
+    }
+    flags |= FLAGS_DATA_MEM;
+  }
+
   /* Init thread control block */
   thread->exc_return    = INIT_EXC_RETURN;
   thread->stk_mem       = stack_mem;
   thread->stk_size      = stack_size;
-  thread->time_slice    = 0U;
-  thread->base_priority = (int8_t)priority;
-  thread->priority      = (int8_t)priority;
+  thread->slice_count   = 0U;
+  thread->quantum       = ThreadQuantum(attr->time_slice);
+  thread->base_priority = (int16_t)priority;
+  thread->priority      = (int16_t)priority;
   thread->id            = ID_THREAD;
-  thread->flags         = 0U;
+  thread->flags         = flags;
   thread->attr          = attr->attr_bits;
   thread->delay         = 0U;
   thread->thread_flags  = 0U;
   thread->name          = attr->name;
+  thread->cpu_time      = 0U;
+  thread->cpu_window    = 0U;
+  thread->cpu_prev      = 0U;
+  thread->cpu_window_idx = osInfo.kernel.tick / osConfig.tick_freq;
+  thread->rel_deadline  = attr->deadline;
+  thread->period        = (attr->period != 0U) ? attr->period : attr->deadline;
+  thread->deadline      = osInfo.kernel.tick + attr->deadline;
+  thread->budget        = 0U;
 
   QueueReset(&thread->thread_que);
   QueueReset(&thread->delay_que);
   QueueReset(&thread->mutex_que);
   QueueReset(&thread->post_queue);
+  QueueReset(&thread->budget_que);
+
+  /* Add to the list of all threads */
+  QueueAppend(&osInfo.thread_list, &thread->list_que);
+  osInfo.thread_count++;
 
   /* Fill all thread stack space by FILL_STACK_VAL */
   uint32_t *ptr = stack_mem;
   for (uint32_t i = stack_size/sizeof(uint32_t); i != 0U; --i) {
     *ptr++ = FILL_STACK_VALUE;
   }
+  /* Sentinel at the stack limit, checked at thread switch */
+  *((uint32_t *)stack_mem) = STACK_MAGIC_WORD;
 
   /* Init thread stack */
   StackAttr_t stack_attr = {
@@ -232,15 +492,16 @@ uint32_t svcThreadGetStackSpace(osThreadId_t thread_id)
 {
   osThread_t *thread = (osThread_t *)thread_id;
   const uint32_t *stack;
-  uint32_t space = 0U;
+  uint32_t space;
 
   /* Check parameters */
   if ((thread == NULL) || (thread->id != ID_THREAD)) {
     return (0U);
   }
 
-  stack = thread->stk_mem;
-  for (; space < thread->stk_size; space += sizeof(uint32_t)) {
+  /* The first word holds the stack sentinel */
+  stack = &((const uint32_t *)thread->stk_mem)[1];
+  for (space = 0U; space < (thread->stk_size - sizeof(uint32_t)); space += sizeof(uint32_t)) {
     if (*stack++ != FILL_STACK_VALUE) {
       break;
     }
@@ -249,13 +510,48 @@ uint32_t svcThreadGetStackSpace(osThreadId_t thread_id)
   return (space);
 }
 
+static
+osStatus_t svcThreadGetCpuTime(osThreadId_t thread_id, uint64_t *cpu_time)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) || (cpu_time == NULL)) {
+    return (osErrorParameter);
+  }
+
+  if ((osConfig.flags & osConfigCpuUsage) != 0U) {
+    krnThreadCpuTimeUpdate();
+  }
+
+  *cpu_time = thread->cpu_time;
+
+  return (osOK);
+}
+
+static
+uint32_t svcThreadGetCpuUsage(osThreadId_t thread_id)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD)) {
+    return (0U);
+  }
+
+  if ((osConfig.flags & osConfigCpuUsage) == 0U) {
+    return (0U);
+  }
+
+  return (krnThreadGetCpuUsage(thread));
+}
+
 static osStatus_t svcThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
 {
   osThread_t *thread = (osThread_t *)thread_id;
 
   /* Check parameters */
-  if ((thread == NULL) || (thread->id != ID_THREAD) ||
-      (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+  if ((thread == NULL) || (thread->id != ID_THREAD) || !IsPriorityValid(priority)) {
     return (osErrorParameter);
   }
 
@@ -264,9 +560,10 @@ static osStatus_t svcThreadSetPriority(osThreadId_t thread_id, osPriority_t prio
     return (osErrorResource);
   }
 
-  if (thread->base_priority != (int8_t)priority) {
-    thread->base_priority = (int8_t)priority;
-    krnThreadSetPriority(thread, (int8_t)priority);
+  if (thread->base_priority != (int16_t)priority) {
+    thread->base_priority = (int16_t)priority;
+    /* Keep the inherited priority and pass the change on to mutex owners */
+    krnMutexOwnerPriorityRestore(thread);
   }
 
   return (osOK);
@@ -302,6 +599,129 @@ static osStatus_t svcThreadYield(void)
   return (osOK);
 }
 
+static osStatus_t svcThreadSetTimeSlice(osThreadId_t thread_id, uint32_t time_slice)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD)) {
+    return (osErrorParameter);
+  }
+
+  /* Check object state */
+  if (thread->state == ThreadTerminated) {
+    return (osErrorResource);
+  }
+
+  thread->quantum     = ThreadQuantum(time_slice);
+  thread->slice_count = 0U;
+
+  return (osOK);
+}
+
+static osStatus_t svcThreadSetDeadline(osThreadId_t thread_id, uint32_t deadline, uint32_t period)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) ||
+      (deadline > 0x7FFFFFFFU) || (period > 0x7FFFFFFFU)) {
+    return (osErrorParameter);
+  }
+
+  /* Check object state */
+  if (thread->state == ThreadTerminated) {
+    return (osErrorResource);
+  }
+
+  if (period == 0U) {
+    period = deadline;
+  }
+
+  if (thread->state == ThreadReady || thread->state == ThreadRunning) {
+    SchedThreadReadyDel(thread, ThreadReady);
+    thread->rel_deadline = deadline;
+    thread->period       = period;
+    thread->deadline     = osInfo.kernel.tick + deadline;
+    SchedThreadReadyAdd(thread);
+    SchedDispatch(NULL);
+  }
+  else {
+    thread->rel_deadline = deadline;
+    thread->period       = period;
+    thread->deadline     = osInfo.kernel.tick + deadline;
+  }
+
+  return (osOK);
+}
+
+static osStatus_t svcThreadSetBudget(osThreadId_t thread_id, uint32_t budget, uint32_t period)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+  uint64_t    count;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) ||
+      ((budget != 0U) && ((period == 0U) || (period > 0x7FFFFFFFU)))) {
+    return (osErrorParameter);
+  }
+
+  /* Check object state */
+  if ((thread->state == ThreadTerminated) || (osInfo.thread.idle == thread)) {
+    return (osErrorResource);
+  }
+
+  count = ((uint64_t)budget * osTickGetClock()) / 1000000U;
+  if (count > 0x7FFFFFFFU) {
+    return (osErrorParameter);
+  }
+
+  /* Charge the running thread before the accounting changes */
+  if (thread == osInfo.thread.run.next) {
+    krnThreadBudgetSwitch(thread);
+  }
+
+  thread->budget         = (uint32_t)count;
+  thread->budget_left    = (int32_t)count;
+  thread->budget_period  = period;
+  thread->budget_release = osInfo.kernel.tick + period;
+
+  if ((thread->flags & FLAGS_BUDGET_EXHAUSTED) != 0U) {
+    thread->flags &= ~FLAGS_BUDGET_EXHAUSTED;
+    QueueRemoveEntry(&thread->budget_que);
+    krnMutexOwnerPriorityRestore(thread);
+  }
+
+  return (osOK);
+}
+
+static osStatus_t svcThreadWaitPeriod(void)
+{
+  osThread_t *thread;
+  uint32_t    release;
+
+  thread = ThreadGetRunning();
+  if (thread->rel_deadline == 0U) {
+    return (osErrorResource);
+  }
+
+  /* Start of the next period and deadline of the next job */
+  release = thread->deadline - thread->rel_deadline + thread->period;
+  thread->deadline = release + thread->rel_deadline;
+
+  release -= osInfo.kernel.tick;
+  if ((release == 0U) || (release > 0x7FFFFFFFU)) {
+    /* The next period has already started: keep running with the new deadline */
+    SchedYield(thread);
+    SchedDispatch(NULL);
+    return (osErrorTimeout);
+  }
+
+  krnThreadWaitEnter(ThreadWaitingDelay, NULL, release);
+
+  return (osOK);
+}
+
 static
 osStatus_t svcThreadSuspend(osThreadId_t thread_id)
 {
@@ -331,9 +751,12 @@ osStatus_t svcThreadSuspend(osThreadId_t thread_id)
 
     case ThreadBlocked:
       /* Remove the thread from delay queue */
-      QueueRemoveEntry(&thread->delay_que);
+      krnWheelRemove(&osInfo.delay, &thread->delay_que);
       /* Remove the thread from wait queue */
       QueueRemoveEntry(&thread->thread_que);
+      if (thread->state == ThreadWaitingMutex) {
+        krnMutexWaitAbort(thread);
+      }
       break;
 
     case ThreadTerminated:
@@ -386,7 +809,14 @@ static void svcThreadExit(void)
   SchedThreadReadyDel(thread, ThreadInactive);
   thread->id = ID_INVALID;
 
+  /* Remove from the list of all threads */
+  QueueRemoveEntry(&thread->list_que);
+  QueueRemoveEntry(&thread->budget_que);
+  osInfo.thread_count--;
+
   SchedDispatch(NULL);
+
+  ThreadFree(thread);
 }
 
 static osStatus_t svcThreadTerminate(osThreadId_t thread_id)
@@ -417,9 +847,12 @@ static osStatus_t svcThreadTerminate(osThreadId_t thread_id)
 
     case ThreadBlocked:
       /* Remove the thread from delay queue */
-      QueueRemoveEntry(&thread->delay_que);
+      krnWheelRemove(&osInfo.delay, &thread->delay_que);
       /* Remove the thread from wait queue */
       QueueRemoveEntry(&thread->thread_que);
+      if (thread->state == ThreadWaitingMutex) {
+        krnMutexWaitAbort(thread);
+      }
       break;
 
     case ThreadInactive:
@@ -435,7 +868,14 @@ static osStatus_t svcThreadTerminate(osThreadId_t thread_id)
 
     thread->id = ID_INVALID;
 
+    /* Remove from the list of all threads */
+    QueueRemoveEntry(&thread->list_que);
+    QueueRemoveEntry(&thread->budget_que);
+    osInfo.thread_count--;
+
     SchedDispatch(NULL);
+
+    ThreadFree(thread);
   }
 
   return (status);
@@ -443,15 +883,25 @@ static osStatus_t svcThreadTerminate(osThreadId_t thread_id)
 
 static uint32_t svcThreadGetCount(void)
 {
-  return (0U);
+  return (osInfo.thread_count);
 }
 
 static uint32_t svcThreadEnumerate(osThreadId_t *thread_array, uint32_t array_items)
 {
-  (void)thread_array;
-  (void)array_items;
+  queue_t  *list = &osInfo.thread_list;
+  queue_t  *que;
+  uint32_t  count = 0U;
+
+  /* Check parameters */
+  if ((thread_array == NULL) || (array_items == 0U)) {
+    return (0U);
+  }
+
+  for (que = list->next; (que != list) && (count < array_items); que = que->next) {
+    thread_array[count++] = GetThreadByListQueue(que);
+  }
 
-  return (0U);
+  return (count);
 }
 
 static uint32_t svcThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
@@ -628,6 +1078,172 @@ bool krnThreadStartup(void)
   return (ret);
 }
 
+/**
+ * @brief       Check the stack of a thread whose context was just saved and
+ *              report an overrun by \ref osKernelErrorNotify.
+ * @param[in]   thread  thread object.
+ * @return      true - stack is intact, false - stack overrun.
+ */
+bool krnThreadStackCheck(const osThread_t *thread)
+{
+  if ((thread->stk <= (uint32_t)thread->stk_mem) ||
+      (*((const uint32_t *)thread->stk_mem) != STACK_MAGIC_WORD)) {
+    (void)osKernelErrorNotify(osKernelErrorStackOverflow, (void *)(uintptr_t)thread);
+    return (false);
+  }
+
+  return (true);
+}
+
+/**
+ * @brief       Free the memory of threads that deleted themselves while running.
+ * @note        Must not be called on the stack of such a thread.
+ */
+void krnThreadFreeExited(void)
+{
+  osThread_t *thread;
+
+  while (!isQueueEmpty(&osInfo.thread.exited)) {
+    thread = GetThreadByQueue(QueueExtract(&osInfo.thread.exited));
+    ThreadMemFree(thread);
+  }
+}
+
+/**
+ * @brief       Charge the CPU time elapsed since the last update to the running thread.
+ */
+void krnThreadCpuTimeUpdate(void)
+{
+  osThread_t *thread = osInfo.thread.run.next;
+  uint32_t    count  = krnSysTimerGetCount();
+  uint32_t    time   = count - osInfo.cpu.stamp;
+  uint32_t    elapsed;
+  uint32_t    idx;
+
+  osInfo.cpu.stamp = count;
+
+  if (thread != NULL) {
+    thread->cpu_time += time;
+
+    idx = CpuWindowGet(count, &elapsed);
+    ThreadCpuWindowRoll(thread, idx);
+
+    /* The time before the start of the window belongs to the previous window */
+    if (time > elapsed) {
+      thread->cpu_prev += time - elapsed;
+      time = elapsed;
+    }
+    thread->cpu_window += time;
+  }
+}
+
+/**
+ * @brief       Charge the running thread for its CPU budget and start
+ *              accounting for the next thread.
+ * @param[in]   thread  thread to be run.
+ */
+void krnThreadBudgetSwitch(osThread_t *thread)
+{
+  osThread_t *prev  = osInfo.thread.run.next;
+  uint32_t    count = krnSysTimerGetCount();
+
+  if ((prev != NULL) && (prev->budget != 0U)) {
+    prev->budget_left -= (int32_t)(count - osInfo.budget.stamp);
+  }
+  osInfo.budget.stamp = count;
+
+  /* The budget of a thread that was not running is replenished on the switch */
+  if ((thread->budget != 0U) &&
+      ((thread->flags & FLAGS_BUDGET_EXHAUSTED) == 0U) &&
+      ((int32_t)(osInfo.kernel.tick - thread->budget_release) >= 0)) {
+    thread->budget_left    = (int32_t)thread->budget;
+    thread->budget_release = osInfo.kernel.tick + thread->budget_period;
+  }
+}
+
+/**
+ * @brief       Charge the running thread for its CPU budget, lower the priority
+ *              of the thread when the budget is used up and replenish budgets.
+ * @return      true - a priority was changed, false - otherwise.
+ */
+bool krnThreadBudgetProcess(void)
+{
+  osThread_t *thread = osInfo.thread.run.next;
+  queue_t    *que;
+  bool        dispatch = false;
+
+  if ((thread != NULL) && (thread->budget != 0U)) {
+    krnThreadBudgetSwitch(thread);
+    /* The budget is checked once a tick, so it is rounded to the nearest tick */
+    if ((thread->budget_left < (int32_t)(osTickGetInterval() / 2U)) &&
+        ((thread->flags & FLAGS_BUDGET_EXHAUSTED) == 0U)) {
+      /* Budget is used up: run in background until the replenishment */
+      thread->flags |= FLAGS_BUDGET_EXHAUSTED;
+      QueueAppend(&osInfo.budget.exhausted, &thread->budget_que);
+      krnMutexOwnerPriorityRestore(thread);
+      dispatch = true;
+    }
+  }
+
+  que = osInfo.budget.exhausted.next;
+  while (que != &osInfo.budget.exhausted) {
+    thread = GetThreadByBudgetQueue(que);
+    que = que->next;
+    if ((int32_t)(osInfo.kernel.tick - thread->budget_release) >= 0) {
+      thread->budget_left    = (int32_t)thread->budget;
+      thread->budget_release = osInfo.kernel.tick + thread->budget_period;
+      thread->flags &= ~FLAGS_BUDGET_EXHAUSTED;
+      QueueRemoveEntry(&thread->budget_que);
+      krnMutexOwnerPriorityRestore(thread);
+      dispatch = true;
+    }
+  }
+
+  return (dispatch);
+}
+
+/**
+ * @brief       Get CPU usage of a thread over the last second, estimated from
+ *              the current and the previous one-second window.
+ * @param[in]   thread    thread object.
+ * @return      CPU usage in percent.
+ */
+uint32_t krnThreadGetCpuUsage(osThread_t *thread)
+{
+  uint32_t length = osConfig.tick_freq * osTickGetInterval();
+  uint32_t elapsed;
+  uint32_t idx;
+  uint64_t time;
+
+  krnThreadCpuTimeUpdate();
+
+  idx = CpuWindowGet(osInfo.cpu.stamp, &elapsed);
+  ThreadCpuWindowRoll(thread, idx);
+
+  /* Approximate the last second by the current window and the part of the
+     previous window still in range, with its CPU time spread evenly */
+  time = thread->cpu_window;
+  if (elapsed < length) {
+    time += ((uint64_t)thread->cpu_prev * (length - elapsed)) / length;
+  }
+
+  /* There is no previous window in the first second */
+  if (idx == 0U) {
+    length = elapsed;
+  }
+
+  if (length == 0U) {
+    return (0U);
+  }
+
+  time = (time * 100U) / length;
+  if (time > 100U) {
+    time = 100U;
+  }
+
+  return ((uint32_t)time);
+}
+
 /**
  * @brief       Exit Thread wait state.
  * @param[out]  thread    thread object.
@@ -635,11 +1251,19 @@ bool krnThreadStartup(void)
  */
 void krnThreadWaitExit(osThread_t *thread, uint32_t ret_val, dispatch_t dispatch)
 {
+  uint8_t state = thread->state;
+
   thread->winfo.ret_val = ret_val;
+  TRACE_EVENT(osTraceWaitExit, thread, ret_val);
 
   /* Remove the thread from delay queue */
-  QueueRemoveEntry(&thread->delay_que);
+  krnWheelRemove(&osInfo.delay, &thread->delay_que);
   SchedThreadReadyAdd(thread);
+
+  /* The thread gave up the mutex and no longer boosts its owner */
+  if ((state == ThreadWaitingMutex) && (ret_val != (uint32_t)osOK)) {
+    krnMutexWaitAbort(thread);
+  }
   if (dispatch != DISPATCH_NO) {
     SchedDispatch(thread);
   }
@@ -653,8 +1277,6 @@ void krnThreadWaitExit(osThread_t *thread, uint32_t ret_val, dispatch_t dispatch
  */
 osStatus_t krnThreadWaitEnter(uint8_t state, queue_t *wait_que, uint32_t timeout)
 {
-  queue_t    *que;
-  queue_t    *delay_queue;
   osThread_t *thread;
 
   if (osInfo.kernel.state != osKernelRunning) {
@@ -662,29 +1284,18 @@ osStatus_t krnThreadWaitEnter(uint8_t state, queue_t *wait_que, uint32_t timeout
   }
 
   thread = ThreadGetRunning();
+  TRACE_EVENT(osTraceWaitEnter | ((uint32_t)state << 8), thread, timeout);
   SchedThreadReadyDel(thread, state);
 
   /* Add to the wait queue */
   if (wait_que != NULL) {
-    for (que = wait_que->next; que != wait_que; que = que->next) {
-      if (thread->priority > GetThreadByQueue(que)->priority) {
-        break;
-      }
-    }
-    QueueAppend(que, &thread->thread_que);
+    krnThreadWaitQueueInsert(wait_que, thread);
   }
 
   /* Add to the delay queue */
   if (timeout != osWaitForever) {
     thread->delay = osInfo.kernel.tick + timeout;
-    delay_queue = &osInfo.delay_queue;
-    for (que = delay_queue->next; que != delay_queue; que = que->next) {
-      if (time_before(thread->delay, GetThreadByDelayQueue(que)->delay)) {
-        break;
-      }
-    }
-
-    QueueAppend(que, &thread->delay_que);
+    krnWheelInsert(&osInfo.delay, &thread->delay_que);
   }
 
   SchedDispatch(NULL);
@@ -692,6 +1303,23 @@ osStatus_t krnThreadWaitEnter(uint8_t state, queue_t *wait_que, uint32_t timeout
   return ((osStatus_t)osThreadWait);
 }
 
+/**
+ * @brief       Insert a waiting thread into a wait queue ordered by priority.
+ * @param[in]   wait_que  wait queue.
+ * @param[in]   thread    thread object.
+ */
+void krnThreadWaitQueueInsert(queue_t *wait_que, osThread_t *thread)
+{
+  queue_t *que;
+
+  for (que = wait_que->next; que != wait_que; que = que->next) {
+    if (thread->priority > GetThreadByQueue(que)->priority) {
+      break;
+    }
+  }
+  QueueAppend(que, &thread->thread_que);
+}
+
 /**
  * @brief
  * @param wait_que
@@ -710,7 +1338,7 @@ void krnThreadWaitDelete(queue_t *wait_que)
  * @param[in]   thread    thread object.
  * @param[in]   priority  new priority value for the thread.
  */
-void krnThreadSetPriority(osThread_t *thread, int8_t priority)
+void krnThreadSetPriority(osThread_t *thread, int16_t priority)
 {
   if (thread->priority != priority) {
     if (thread->state == ThreadReady || thread->state == ThreadRunning) {
@@ -850,6 +1478,44 @@ uint32_t osThreadGetStackSpace(osThreadId_t thread_id)
   return (stack_space);
 }
 
+/**
+ * @fn          uint64_t osThreadGetCpuTime(osThreadId_t thread_id)
+ * @brief       Get CPU time consumed by a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      CPU time in system timer counts or 0 in case of an error.
+ */
+uint64_t osThreadGetCpuTime(osThreadId_t thread_id)
+{
+  uint64_t cpu_time = 0U;
+
+  if (!IsIrqMode() && !IsIrqMasked()) {
+    (void)SVC_2(thread_id, &cpu_time, svcThreadGetCpuTime);
+  }
+
+  return (cpu_time);
+}
+
+/**
+ * @fn          uint32_t osThreadGetCpuUsage(osThreadId_t thread_id)
+ * @brief       Get CPU usage of a thread over the last second, estimated from
+ *              the current and the previous one-second window.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      CPU usage in percent or 0 in case of an error.
+ */
+uint32_t osThreadGetCpuUsage(osThreadId_t thread_id)
+{
+  uint32_t usage;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    usage = 0U;
+  }
+  else {
+    usage = SVC_1(thread_id, svcThreadGetCpuUsage);
+  }
+
+  return (usage);
+}
+
 /**
  * @fn          osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
  * @brief       Change priority of a thread.
@@ -910,6 +1576,92 @@ osStatus_t osThreadYield(void)
   return (status);
 }
 
+/**
+ * @fn          osStatus_t osThreadSetTimeSlice(osThreadId_t thread_id, uint32_t time_slice)
+ * @brief       Change the round-robin time slice of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   time_slice  time slice in ticks, 0 - run until blocked,
+ *                          \ref osThreadTimeSliceDefault - robin timeout of the kernel configuration.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadSetTimeSlice(osThreadId_t thread_id, uint32_t time_slice)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_2(thread_id, time_slice, svcThreadSetTimeSlice);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osThreadSetDeadline(osThreadId_t thread_id, uint32_t deadline, uint32_t period)
+ * @brief       Change the deadline and the period of a thread and start a new job.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   deadline    relative deadline in ticks, 0 - schedule by priority only.
+ * @param[in]   period      period in ticks, 0 - equal to the deadline.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadSetDeadline(osThreadId_t thread_id, uint32_t deadline, uint32_t period)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_3(thread_id, deadline, period, svcThreadSetDeadline);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osThreadSetBudget(osThreadId_t thread_id, uint32_t budget, uint32_t period)
+ * @brief       Limit the CPU time of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   budget      CPU time per period in microseconds, 0 - no limit.
+ * @param[in]   period      replenishment period in ticks.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadSetBudget(osThreadId_t thread_id, uint32_t budget, uint32_t period)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_3(thread_id, budget, period, svcThreadSetBudget);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osThreadWaitPeriod(void)
+ * @brief       Finish the current job of the running thread and wait for the
+ *              start of the next period.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadWaitPeriod(void)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)SVC_0(svcThreadWaitPeriod);
+  }
+
+  return (status);
+}
+
 /**
  * @fn          osStatus_t osThreadSuspend(osThreadId_t thread_id)
  * @brief       Suspend execution of a thread.
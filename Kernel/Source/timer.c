@@ -39,28 +39,145 @@
 #define osTimerStopped       0x01U   ///< Timer Stopped
 #define osTimerRunning       0x02U   ///< Timer Running
 
+/* Number of ticks covered by the timer wheel */
+#define TIMER_WHEEL_RANGE    (1UL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BITS))
+
+/* Event time of the wheel entry */
+#define WheelGetTime(wheel, que)  (*(uint32_t *)(void *)((uint8_t *)(que) + (wheel)->offset))
+
 /*******************************************************************************
  *  Helper functions
  ******************************************************************************/
 
+/**
+ * @brief       Get number of trailing zeros.
+ * @param[in]   value   non-zero value.
+ * @return      number of trailing zeros.
+ */
+__STATIC_INLINE
+uint32_t WheelCountTrailingZeros(uint32_t value)
+{
+  return (31U - __CLZ(value & (0U - value)));
+}
+
+/**
+ * @brief       Rotate right the slot bitmap of a wheel level.
+ * @param[in]   bmp     slot bitmap.
+ * @param[in]   shift   number of slots.
+ * @return      rotated bitmap.
+ */
+__STATIC_INLINE
+uint32_t WheelBitmapRotate(uint32_t bmp, uint32_t shift)
+{
+  shift &= TIMER_WHEEL_MASK;
+  if (shift == 0U) {
+    return (bmp);
+  }
+
+  return ((bmp >> shift) | (bmp << (TIMER_WHEEL_SIZE - shift)));
+}
+
+/**
+ * @brief       Move the entries of an upper level slot to the lower levels.
+ * @param[in]   wheel   timer wheel.
+ * @param[in]   level   wheel level.
+ * @param[in]   slot    slot index.
+ */
+static void WheelCascade(TimerWheel_t *wheel, uint32_t level, uint32_t slot)
+{
+  queue_t que;
+
+  if ((wheel->bmp[level] & (1UL << slot)) == 0U) {
+    return;
+  }
+
+  QueueReset(&que);
+  QueueMove(&que, &wheel->wheel[level][slot]);
+  wheel->bmp[level] &= ~(1UL << slot);
+
+  while (!isQueueEmpty(&que)) {
+    krnWheelInsert(wheel, QueueExtract(&que));
+  }
+}
+
+/**
+ * @brief       Get number of ticks until the next non-empty slot is processed.
+ * @param[in]   wheel   timer wheel.
+ * @return      number of ticks or osWaitForever if the wheel is empty.
+ */
+static uint32_t WheelNext(TimerWheel_t *wheel)
+{
+  uint32_t tick = wheel->tick;
+  uint32_t next = osWaitForever;
+  uint32_t shift;
+  uint32_t bmp;
+  uint32_t ticks;
+
+  for (uint32_t level = 0U; level < TIMER_WHEEL_LEVELS; level++) {
+    bmp = wheel->bmp[level];
+    if (bmp != 0U) {
+      shift = level * TIMER_WHEEL_BITS;
+      bmp   = WheelBitmapRotate(bmp, tick >> shift);
+      if ((tick & ((1UL << shift) - 1U)) == 0U) {
+        /* The current slot of the level is processed at this tick */
+        ticks = WheelCountTrailingZeros(bmp);
+      }
+      else {
+        ticks = WheelCountTrailingZeros(WheelBitmapRotate(bmp, 1U)) + 1U;
+      }
+      ticks = (((tick >> shift) + ticks) << shift) - tick;
+      if (ticks < next) {
+        next = ticks;
+      }
+    }
+  }
+
+  return (next);
+}
+
+/**
+ * @brief       Process the current tick of the timer wheel.
+ * @param[in]   wheel   timer wheel.
+ */
+static void WheelStep(TimerWheel_t *wheel)
+{
+  uint32_t tick = wheel->tick;
+  uint32_t slot = tick & TIMER_WHEEL_MASK;
+  uint32_t level;
+
+  /* Cascade the upper levels when the lower level wraps around */
+  for (level = 1U; level < TIMER_WHEEL_LEVELS; level++) {
+    if (((tick >> ((level - 1U) * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK) != 0U) {
+      break;
+    }
+    WheelCascade(wheel, level, (tick >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK);
+  }
+
+  /* Move the entries expiring at this tick to the expired list */
+  if ((wheel->bmp[0] & (1UL << slot)) != 0U) {
+    QueueMove(&wheel->expired, &wheel->wheel[0][slot]);
+    wheel->bmp[0] &= ~(1UL << slot);
+  }
+
+  wheel->tick = tick + 1U;
+}
+
 static osTimerFinfo_t *TimerGetFinfo(void)
 {
   osTimer_t      *timer;
   osTimerFinfo_t *timer_finfo = NULL;
-  queue_t        *timer_queue = &osInfo.timer_queue;
+  queue_t        *timer_queue = &osInfo.timer.expired;
 
   if (!isQueueEmpty(timer_queue)) {
     timer = GetTimerByQueue(timer_queue->next);
-    if (time_before_eq(timer->time, osInfo.kernel.tick)) {
-      krnTimerRemove(timer);
-      if (timer->type == osTimerPeriodic) {
-        krnTimerInsert(timer, timer->load);
-      }
-      else {
-        timer->state = osTimerStopped;
-      }
-      timer_finfo = &timer->finfo;
+    krnTimerRemove(timer);
+    if (timer->type == osTimerPeriodic) {
+      krnTimerInsert(timer, timer->load);
+    }
+    else {
+      timer->state = osTimerStopped;
     }
+    timer_finfo = &timer->finfo;
   }
 
   return (timer_finfo);
@@ -70,26 +187,140 @@ static osTimerFinfo_t *TimerGetFinfo(void)
  *  Library functions
  ******************************************************************************/
 
-void krnTimerInsert(osTimer_t *timer, uint32_t time)
+void krnWheelInit(TimerWheel_t *wheel, ptrdiff_t offset)
 {
-  queue_t *que;
-  queue_t *timer_queue;
+  wheel->tick   = osInfo.kernel.tick + 1U;
+  wheel->offset = offset;
+  QueueReset(&wheel->expired);
+
+  for (uint32_t i = 0U; i < TIMER_WHEEL_LEVELS; i++) {
+    wheel->bmp[i] = 0U;
+    for (uint32_t j = 0U; j < TIMER_WHEEL_SIZE; j++) {
+      QueueReset(&wheel->wheel[i][j]);
+    }
+  }
+}
 
-  timer_queue = &osInfo.timer_queue;
-  timer->time = time + osInfo.kernel.tick;
+void krnWheelInsert(TimerWheel_t *wheel, queue_t *que)
+{
+  uint32_t time  = WheelGetTime(wheel, que);
+  uint32_t delta = time - wheel->tick;
+  uint32_t level = 0U;
+  uint32_t slot;
+
+  if (time_before(time, wheel->tick)) {
+    time  = wheel->tick;
+    delta = 0U;
+  }
+  else if (delta >= TIMER_WHEEL_RANGE) {
+    /* Beyond the wheel range: cascade again from the last level */
+    time  = wheel->tick + (TIMER_WHEEL_RANGE - 1U);
+    delta = TIMER_WHEEL_RANGE - 1U;
+  }
+
+  while (delta >= TIMER_WHEEL_SIZE) {
+    delta >>= TIMER_WHEEL_BITS;
+    level++;
+  }
+
+  slot = (time >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
 
-  for (que = timer_queue->next; que != timer_queue; que = que->next) {
-    if (time_before(timer->time, GetTimerByQueue(que)->time)) {
+  QueueAppend(&wheel->wheel[level][slot], que);
+  wheel->bmp[level] |= (1UL << slot);
+}
+
+void krnWheelRemove(TimerWheel_t *wheel, queue_t *que)
+{
+  queue_t  *head = que->next;
+  uintptr_t index;
+
+  /* Clear the slot bit when the last entry leaves a wheel slot */
+  if ((head != que) && (head == que->prev)) {
+    index = ((uintptr_t)head - (uintptr_t)&wheel->wheel[0][0]) / sizeof(queue_t);
+    if (index < (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SIZE)) {
+      wheel->bmp[index >> TIMER_WHEEL_BITS] &= ~(1UL << (index & TIMER_WHEEL_MASK));
+    }
+  }
+
+  QueueRemoveEntry(que);
+}
+
+bool krnWheelProcess(TimerWheel_t *wheel)
+{
+  uint32_t ticks;
+
+  while (time_before_eq(wheel->tick, osInfo.kernel.tick)) {
+    ticks = WheelNext(wheel);
+    if (ticks > (osInfo.kernel.tick - wheel->tick)) {
+      /* No wheel events up to the current tick */
+      wheel->tick = osInfo.kernel.tick + 1U;
       break;
     }
+    wheel->tick += ticks;
+    WheelStep(wheel);
   }
 
-  QueueAppend(que, &timer->timer_que);
+  return (!isQueueEmpty(&wheel->expired));
+}
+
+uint32_t krnWheelGetNext(TimerWheel_t *wheel)
+{
+  queue_t  *que;
+  queue_t  *slot;
+  uint32_t  tick = wheel->tick;
+  uint32_t  next = osWaitForever;
+  uint32_t  time;
+  uint32_t  shift;
+  uint32_t  base;
+  uint32_t  bmp;
+  uint32_t  k;
+
+  if (!isQueueEmpty(&wheel->expired)) {
+    return (0U);
+  }
+
+  for (uint32_t level = 0U; level < TIMER_WHEEL_LEVELS; level++) {
+    shift = level * TIMER_WHEEL_BITS;
+    base  = tick >> shift;
+    bmp   = WheelBitmapRotate(wheel->bmp[level], base);
+
+    /* Scan the slots in expiration order while they may hold an earlier entry */
+    while (bmp != 0U) {
+      k    = WheelCountTrailingZeros(bmp);
+      bmp &= bmp - 1U;
+      if ((k != 0U) && ((((base + k) << shift) - tick) >= next)) {
+        break;
+      }
+      slot = &wheel->wheel[level][(base + k) & TIMER_WHEEL_MASK];
+      for (que = slot->next; que != slot; que = que->next) {
+        time = WheelGetTime(wheel, que);
+        if (time_before(time, tick)) {
+          next = 0U;
+        }
+        else if ((time - tick) < next) {
+          next = time - tick;
+        }
+      }
+    }
+  }
+
+  if (next != osWaitForever) {
+    next = (tick + next) - osInfo.kernel.tick;
+  }
+
+  return (next);
+}
+
+void krnTimerInsert(osTimer_t *timer, uint32_t time)
+{
+  timer->time = time + osInfo.kernel.tick;
+
+  krnWheelInsert(&osInfo.timer, &timer->timer_que);
 }
 
 void krnTimerRemove(osTimer_t *timer)
 {
-  QueueRemoveEntry(&timer->timer_que);
+  krnWheelRemove(&osInfo.timer, &timer->timer_que);
 }
 
 void krnTimerThread(void *argument)
@@ -112,26 +343,50 @@ void krnTimerThread(void *argument)
 
 static osTimerId_t svcTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr)
 {
-  osTimer_t *timer;
+  osTimer_t  *timer;
+  const char *name;
+  uint8_t     flags;
 
   /* Check parameters */
-  if ((func == NULL) || (attr == NULL) || ((type != osTimerOnce) && (type != osTimerPeriodic))) {
+  if ((func == NULL) || ((type != osTimerOnce) && (type != osTimerPeriodic))) {
     return NULL;
   }
 
-  timer = attr->cb_mem;
+  if (attr != NULL) {
+    timer = attr->cb_mem;
+    name  = attr->name;
 
-  /* Check parameters */
-  if ((timer == NULL) || (((uint32_t)timer & 3U) != 0U) || (attr->cb_size < sizeof(osTimer_t))) {
-    return (NULL);
+    /* Check parameters */
+    if (timer != NULL) {
+      if ((((uint32_t)timer & 3U) != 0U) || (attr->cb_size < sizeof(osTimer_t))) {
+        return (NULL);
+      }
+    }
+    else if (attr->cb_size != 0U) {
+      return (NULL);
+    }
+  }
+  else {
+    timer = NULL;
+    name  = NULL;
+  }
+
+  /* Allocate object memory if not provided */
+  flags = 0U;
+  if (timer == NULL) {
+    timer = krnObjectMemAlloc(osConfig.mpi.timer, sizeof(osTimer_t));
+    if (timer == NULL) {
+      return (NULL);
+    }
+    flags = FLAGS_OBJECT_MEM;
   }
 
   /* Initialize control block */
   timer->id         = ID_TIMER;
   timer->state      = osTimerStopped;
-  timer->flags      = 0U;
+  timer->flags      = flags;
   timer->type       = (uint8_t)type;
-  timer->name       = attr->name;
+  timer->name       = name;
   timer->load       = 0U;
   timer->time       = 0U;
   timer->finfo.func = func;
@@ -234,6 +489,11 @@ static osStatus_t svcTimerDelete(osTimerId_t timer_id)
   timer->state = osTimerInactive;
   timer->id    = ID_INVALID;
 
+  /* Free object memory */
+  if ((timer->flags & FLAGS_OBJECT_MEM) != 0U) {
+    krnObjectMemFree(osConfig.mpi.timer, timer);
+  }
+
   return (osOK);
 }
 
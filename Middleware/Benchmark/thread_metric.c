@@ -0,0 +1,550 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * Thread-Metric style kernel benchmark.
+ *
+ * Every test starts worker threads that repeat one kernel operation and
+ * count it. The benchmark thread sleeps for the test duration and reads the
+ * count and the system timer before and after. The result is the number of
+ * operations per second and the core clock cycles per operation.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "Benchmark/thread_metric.h"
+#include "Kernel/kernel.h"
+#include "Kernel/tick.h"
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#ifndef THREAD_METRIC_STACK_SIZE
+#if (osThreadStackSizeMin > 512U)
+#define THREAD_METRIC_STACK_SIZE      osThreadStackSizeMin
+#else
+#define THREAD_METRIC_STACK_SIZE      512U
+#endif
+#endif
+
+#define NUM_WORKERS                   2U
+#define MSG_COUNT                     4U
+#define BLOCK_COUNT                   4U
+#define BLOCK_SIZE                    32U
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef struct Test_s {
+  const char                   *name;
+  bool                (*Start)(void);   ///< Create the objects and the workers
+} const Test_t;
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+static bool YieldStart(void);
+static bool PreemptStart(void);
+static bool IrqWakeStart(void);
+static bool QueueStart(void);
+static bool SemaphoreStart(void);
+static bool MutexStart(void);
+static bool MutexCeilingStart(void);
+static bool MemoryPoolStart(void);
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static Test_t tests[] = {
+  { "Cooperative yield",          YieldStart        },
+  { "Preemptive switch",          PreemptStart      },
+  { "ISR to thread wake",         IrqWakeStart      },
+  { "Message queue round-trip",   QueueStart        },
+  { "Semaphore ping-pong",        SemaphoreStart    },
+  { "Mutex handoff (inherit)",    MutexStart        },
+  { "Mutex handoff (ceiling)",    MutexCeilingStart },
+  { "Memory pool alloc/free",     MemoryPoolStart   },
+};
+
+static ThreadMetricPort_t *bench_port;
+static volatile uint32_t   bench_count;
+static const char         *skip_reason;
+
+static osThreadId_t       worker[NUM_WORKERS];
+static osThread_t         worker_cb[NUM_WORKERS];
+static uint64_t           worker_stack[NUM_WORKERS][THREAD_METRIC_STACK_SIZE/8U] __attribute__((section(".bss.os.thread.stack")));
+
+static osSemaphoreId_t    sem[2];
+static osSemaphore_t      sem_cb[2];
+
+static osMessageQueueId_t mq[2];
+static osMessageQueue_t   mq_cb[2];
+/* Sized with osMessage_t rather than osMessageQueueMemSize to run on 64-bit hosts */
+static uint32_t           mq_mem[2][(MSG_COUNT * (sizeof(uint32_t) + sizeof(osMessage_t)))/4U];
+
+static osMutexId_t        mutex;
+static osMutex_t          mutex_cb;
+
+static osMemoryPoolId_t   mp;
+static osMemoryPool_t     mp_cb;
+static uint32_t           mp_mem[osMemoryPoolMemSize(BLOCK_COUNT, BLOCK_SIZE)/4U];
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+/**
+ * @brief       Record why the current test is skipped.
+ * @param[in]   reason    reason printed with the result.
+ * @return      false.
+ */
+static bool Skip(const char *reason)
+{
+  skip_reason = reason;
+
+  return (false);
+}
+
+static bool WorkerNew(uint32_t index, osThreadFunc_t func, osPriority_t priority)
+{
+  static osThreadAttr_t attr;
+
+  if (sizeof(worker_stack[index]) < osThreadStackSizeMin) {
+    return (Skip("THREAD_METRIC_STACK_SIZE below osThreadStackSizeMin"));
+  }
+
+  attr.name       = NULL;
+  attr.attr_bits  = 0U;
+  attr.cb_mem     = &worker_cb[index];
+  attr.cb_size    = sizeof(worker_cb[index]);
+  attr.stack_mem  = &worker_stack[index][0];
+  attr.stack_size = sizeof(worker_stack[index]);
+  attr.priority   = priority;
+
+  worker[index] = osThreadNew(func, NULL, &attr);
+
+  if (worker[index] == NULL) {
+    return (Skip("osThreadNew failed"));
+  }
+
+  return (true);
+}
+
+static bool SemaphoreNew(uint32_t index)
+{
+  static osSemaphoreAttr_t attr;
+
+  attr.name      = NULL;
+  attr.attr_bits = 0U;
+  attr.cb_mem    = &sem_cb[index];
+  attr.cb_size   = sizeof(sem_cb[index]);
+
+  sem[index] = osSemaphoreNew(1U, 0U, &attr);
+
+  if (sem[index] == NULL) {
+    return (Skip("osSemaphoreNew failed"));
+  }
+
+  return (true);
+}
+
+static bool MessageQueueNew(uint32_t index)
+{
+  static osMessageQueueAttr_t attr;
+
+  attr.name      = NULL;
+  attr.attr_bits = 0U;
+  attr.cb_mem    = &mq_cb[index];
+  attr.cb_size   = sizeof(mq_cb[index]);
+  attr.mq_mem    = &mq_mem[index][0];
+  attr.mq_size   = sizeof(mq_mem[index]);
+
+  mq[index] = osMessageQueueNew(MSG_COUNT, sizeof(uint32_t), &attr);
+
+  if (mq[index] == NULL) {
+    return (Skip("osMessageQueueNew failed"));
+  }
+
+  return (true);
+}
+
+/**
+ * @brief       Terminate the workers and delete the objects of a test.
+ */
+static void TestStop(void)
+{
+  for (uint32_t i = 0U; i < NUM_WORKERS; i++) {
+    if (worker[i] != NULL) {
+      (void)osThreadTerminate(worker[i]);
+      worker[i] = NULL;
+    }
+  }
+
+  for (uint32_t i = 0U; i < 2U; i++) {
+    if (sem[i] != NULL) {
+      (void)osSemaphoreDelete(sem[i]);
+      sem[i] = NULL;
+    }
+    if (mq[i] != NULL) {
+      (void)osMessageQueueDelete(mq[i]);
+      mq[i] = NULL;
+    }
+  }
+
+  if (mutex != NULL) {
+    (void)osMutexDelete(mutex);
+    mutex = NULL;
+  }
+
+  if (mp != NULL) {
+    (void)osMemoryPoolDelete(mp);
+    mp = NULL;
+  }
+}
+
+/**
+ * @brief       Run a test and print the result.
+ * @param[in]   test      test.
+ * @param[in]   duration  duration of the test [ms].
+ */
+static void TestRun(Test_t *test, uint32_t duration)
+{
+  uint32_t freq = osKernelGetSysTimerFreq();
+  uint32_t count;
+  uint32_t start;
+  uint32_t time;
+
+  bench_count = 0U;
+  skip_reason = NULL;
+
+  if (!test->Start()) {
+    TestStop();
+    bench_port->printf("%-28s %10s: %s\r\n", test->name, "skipped", skip_reason);
+    return;
+  }
+
+  /* Let the workers reach the steady state */
+  osDelay(1U);
+
+  count = bench_count;
+  start = osKernelGetSysTimerCount();
+  osDelay((uint32_t)(((uint64_t)duration * osKernelGetTickFreq()) / 1000U));
+  time  = osKernelGetSysTimerCount() - start;
+  count = bench_count - count;
+
+  TestStop();
+
+  if ((count == 0U) || (time == 0U)) {
+    bench_port->printf("%-28s %10s\r\n", test->name, "failed");
+    return;
+  }
+
+  bench_port->printf("%-28s %10u ops/s %8u cycles/op\r\n", test->name,
+                     (uint32_t)(((uint64_t)count * freq) / time),
+                     (uint32_t)((((uint64_t)time * SystemCoreClock) / freq) / count));
+}
+
+/* Cooperative yield: two threads of the same priority */
+static void YieldWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    bench_count++;
+    osThreadYield();
+  }
+}
+
+static bool YieldStart(void)
+{
+  return (WorkerNew(0U, YieldWorker, osPriorityNormal) &&
+          WorkerNew(1U, YieldWorker, osPriorityNormal));
+}
+
+/* Preemptive switch: a thread resumes a higher priority thread */
+static void PreemptLowWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osThreadResume(worker[1]);
+  }
+}
+
+static void PreemptHighWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    bench_count++;
+    (void)osThreadSuspend(osThreadGetId());
+  }
+}
+
+static bool PreemptStart(void)
+{
+  return (WorkerNew(0U, PreemptLowWorker,  osPriorityNormal) &&
+          WorkerNew(1U, PreemptHighWorker, osPriorityAboveNormal));
+}
+
+/* ISR to thread wake: the interrupt releases a semaphore */
+static void IrqWakeLowWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    bench_port->IrqTrigger();
+  }
+}
+
+static void IrqWakeHighWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osSemaphoreAcquire(sem[0], osWaitForever);
+    bench_count++;
+  }
+}
+
+static bool IrqWakeStart(void)
+{
+  if (bench_port->IrqTrigger == NULL) {
+    return (Skip("no IrqTrigger in the port"));
+  }
+
+  return (SemaphoreNew(0U) &&
+          WorkerNew(0U, IrqWakeLowWorker,  osPriorityNormal) &&
+          WorkerNew(1U, IrqWakeHighWorker, osPriorityAboveNormal));
+}
+
+/* Message queue round-trip: request and reply through two queues */
+static void QueueClientWorker(void *argument)
+{
+  uint32_t msg = 0U;
+  (void)argument;
+
+  for (;;) {
+    (void)osMessageQueuePut(mq[0], &msg, 0U, osWaitForever);
+    (void)osMessageQueueGet(mq[1], &msg, NULL, osWaitForever);
+    bench_count++;
+  }
+}
+
+static void QueueServerWorker(void *argument)
+{
+  uint32_t msg;
+  (void)argument;
+
+  for (;;) {
+    (void)osMessageQueueGet(mq[0], &msg, NULL, osWaitForever);
+    msg++;
+    (void)osMessageQueuePut(mq[1], &msg, 0U, osWaitForever);
+  }
+}
+
+static bool QueueStart(void)
+{
+  return (MessageQueueNew(0U) && MessageQueueNew(1U) &&
+          WorkerNew(0U, QueueClientWorker, osPriorityNormal) &&
+          WorkerNew(1U, QueueServerWorker, osPriorityAboveNormal));
+}
+
+/* Semaphore ping-pong between two threads */
+static void SemaphorePingWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osSemaphoreRelease(sem[0]);
+    (void)osSemaphoreAcquire(sem[1], osWaitForever);
+    bench_count++;
+  }
+}
+
+static void SemaphorePongWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osSemaphoreAcquire(sem[0], osWaitForever);
+    (void)osSemaphoreRelease(sem[1]);
+  }
+}
+
+static bool SemaphoreStart(void)
+{
+  return (SemaphoreNew(0U) && SemaphoreNew(1U) &&
+          WorkerNew(0U, SemaphorePingWorker, osPriorityNormal) &&
+          WorkerNew(1U, SemaphorePongWorker, osPriorityAboveNormal));
+}
+
+/* Mutex handoff: the owner inherits the priority of the waiting thread and
+   passes the mutex on release */
+static void MutexLowWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osMutexAcquire(mutex, osWaitForever);
+    (void)osThreadResume(worker[1]);
+    (void)osMutexRelease(mutex);
+  }
+}
+
+static void MutexHighWorker(void *argument)
+{
+  (void)argument;
+
+  for (;;) {
+    (void)osMutexAcquire(mutex, osWaitForever);
+    (void)osMutexRelease(mutex);
+    bench_count++;
+    (void)osThreadSuspend(osThreadGetId());
+  }
+}
+
+static bool MutexStart(void)
+{
+  static const osMutexAttr_t attr = {
+    NULL,
+    osMutexPrioInherit,
+    &mutex_cb,
+    sizeof(mutex_cb),
+    osPriorityNone,
+  };
+
+  mutex = osMutexNew(&attr);
+  if (mutex == NULL) {
+    return (Skip("osMutexNew failed"));
+  }
+
+  return (WorkerNew(1U, MutexHighWorker, osPriorityAboveNormal) &&
+          WorkerNew(0U, MutexLowWorker,  osPriorityNormal));
+}
+
+/* Mutex handoff with a priority ceiling: the owner runs at the ceiling, so
+   the resumed thread runs and takes the mutex only after the release */
+static bool MutexCeilingStart(void)
+{
+  static const osMutexAttr_t attr = {
+    NULL,
+    osMutexPrioCeiling,
+    &mutex_cb,
+    sizeof(mutex_cb),
+    osPriorityAboveNormal,
+  };
+
+  mutex = osMutexNew(&attr);
+  if (mutex == NULL) {
+    return (Skip("osMutexNew failed"));
+  }
+
+  return (WorkerNew(1U, MutexHighWorker, osPriorityAboveNormal) &&
+          WorkerNew(0U, MutexLowWorker,  osPriorityNormal));
+}
+
+/* Memory pool: allocate and free a block */
+static void MemoryPoolWorker(void *argument)
+{
+  void *block;
+  (void)argument;
+
+  for (;;) {
+    block = osMemoryPoolAlloc(mp, 0U);
+    (void)osMemoryPoolFree(mp, block);
+    bench_count++;
+  }
+}
+
+static bool MemoryPoolStart(void)
+{
+  static const osMemoryPoolAttr_t attr = {
+    NULL,
+    0U,
+    &mp_cb,
+    sizeof(mp_cb),
+    &mp_mem[0],
+    sizeof(mp_mem),
+  };
+
+  mp = osMemoryPoolNew(BLOCK_COUNT, BLOCK_SIZE, &attr);
+  if (mp == NULL) {
+    return (Skip("osMemoryPoolNew failed"));
+  }
+
+  return (WorkerNew(0U, MemoryPoolWorker, osPriorityNormal));
+}
+
+/*******************************************************************************
+ *  function implementations (scope: module-exported)
+ ******************************************************************************/
+
+/**
+ * @brief       Run all tests and print the results.
+ * @param[in]   port  board support.
+ */
+void ThreadMetricRun(ThreadMetricPort_t *port)
+{
+  osThreadId_t thread = osThreadGetId();
+  osPriority_t priority;
+  uint32_t     duration;
+
+  if ((port == NULL) || (port->printf == NULL) || (thread == NULL)) {
+    return;
+  }
+
+  bench_port = port;
+  duration   = (port->duration != 0U) ? port->duration : 1000U;
+
+  priority = osThreadGetPriority(thread);
+  (void)osThreadSetPriority(thread, osPriorityRealtime);
+
+  port->printf("mbOS Thread-Metric: %u ms per test, core clock %u Hz\r\n",
+               duration, SystemCoreClock);
+
+  for (uint32_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+    TestRun(&tests[i], duration);
+  }
+
+  (void)osThreadSetPriority(thread, priority);
+}
+
+/**
+ * @brief       Benchmark interrupt handler.
+ */
+void ThreadMetricIrqHandler(void)
+{
+  if (sem[0] != NULL) {
+    (void)osSemaphoreRelease(sem[0]);
+  }
+}
+
+/* ----------------------------- End of file ---------------------------------*/
@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2022 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Kernel trace decoder.
+ *
+ * Converts a dumped trace buffer (see Include/Kernel/trace.h) to the Chrome
+ * trace event JSON format, which is displayed by chrome://tracing and
+ * https://ui.perfetto.dev. Every thread gets its own track with the running
+ * intervals, Service Calls and waits; ticks and ISR post processing go to the
+ * "Kernel" track.
+ *
+ * Function and object addresses are resolved with the symbol table of the
+ * application, as printed by nm:
+ *   arm-none-eabi-nm app.elf > app.sym
+ *   trace2json -s app.sym trace.bin > trace.json
+ *
+ * Build:
+ *   cc -O2 -IInclude Tools/Trace/trace2json.c -o trace2json
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Kernel/trace.h>
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define MAX_THREADS                   (256U)
+#define MAX_SYMBOL_NAME               (128U)
+
+#define TID_KERNEL                    (0U)
+#define TID_UNKNOWN                   (1U)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef struct Symbol_s {
+  uint32_t                       addr;
+  char        name[MAX_SYMBOL_NAME];
+} Symbol_t;
+
+typedef struct Thread_s {
+  uint32_t                       addr;
+  uint32_t                      depth;  ///< Open Service Calls
+} Thread_t;
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static Symbol_t *symbols;
+static uint32_t  symbol_count;
+
+static Thread_t  threads[MAX_THREADS];
+static uint32_t  thread_count;
+
+static bool      first_event = true;
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static uint32_t GetWord(const uint8_t *p)
+{
+  return ((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static int SymbolCompare(const void *a, const void *b)
+{
+  uint32_t addr_a = ((const Symbol_t *)a)->addr;
+  uint32_t addr_b = ((const Symbol_t *)b)->addr;
+
+  return ((addr_a > addr_b) - (addr_a < addr_b));
+}
+
+/**
+ * @brief       Load the symbol table printed by nm.
+ * @param[in]   path  file name.
+ * @return      true on success.
+ */
+static bool SymbolLoad(const char *path)
+{
+  FILE     *file;
+  char      line[256];
+  char      type;
+  char      name[MAX_SYMBOL_NAME];
+  uint32_t  addr;
+  uint32_t  capacity = 0U;
+
+  file = fopen(path, "r");
+  if (file == NULL) {
+    return (false);
+  }
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (sscanf(line, "%" SCNx32 " %c %127s", &addr, &type, name) != 3) {
+      continue;
+    }
+    if (symbol_count == capacity) {
+      capacity = (capacity == 0U) ? 256U : (capacity * 2U);
+      symbols  = realloc(symbols, capacity * sizeof(Symbol_t));
+      if (symbols == NULL) {
+        fclose(file);
+        return (false);
+      }
+    }
+    symbols[symbol_count].addr = addr;
+    strcpy(symbols[symbol_count].name, name);
+    symbol_count++;
+  }
+
+  fclose(file);
+  qsort(symbols, symbol_count, sizeof(Symbol_t), SymbolCompare);
+
+  return (true);
+}
+
+/**
+ * @brief       Find the symbol at the address.
+ * @param[in]   addr  address, the Thumb bit of functions is ignored.
+ * @return      symbol name or NULL.
+ */
+static const char *SymbolFind(uint32_t addr)
+{
+  uint32_t lo = 0U;
+  uint32_t hi = symbol_count;
+  uint32_t mid;
+
+  while (lo < hi) {
+    mid = (lo + hi) / 2U;
+    if (symbols[mid].addr == addr || symbols[mid].addr == (addr & ~1U)) {
+      return (symbols[mid].name);
+    }
+    if (symbols[mid].addr < (addr & ~1U)) {
+      lo = mid + 1U;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return (NULL);
+}
+
+static void PrintName(uint32_t addr)
+{
+  const char *name = SymbolFind(addr);
+
+  if (name != NULL) {
+    printf("%s", name);
+  }
+  else {
+    printf("0x%08" PRIX32, addr);
+  }
+}
+
+static void PrintEventBegin(const char *ph, const char *cat, uint32_t tid, double ts)
+{
+  printf("%s\n  {\"ph\":\"%s\",\"cat\":\"%s\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f",
+         first_event ? "" : ",", ph, cat, tid, ts);
+  first_event = false;
+}
+
+/**
+ * @brief       Get the track of a thread.
+ * @param[in]   addr  thread control block address.
+ * @return      thread or NULL if the table is full.
+ */
+static Thread_t *ThreadGet(uint32_t addr)
+{
+  for (uint32_t i = 0U; i < thread_count; i++) {
+    if (threads[i].addr == addr) {
+      return (&threads[i]);
+    }
+  }
+
+  if (thread_count == MAX_THREADS) {
+    return (NULL);
+  }
+
+  threads[thread_count].addr  = addr;
+  threads[thread_count].depth = 0U;
+
+  return (&threads[thread_count++]);
+}
+
+static uint32_t ThreadTid(uint32_t addr)
+{
+  return ((addr == 0U) ? TID_UNKNOWN : addr);
+}
+
+static const char *ObjectName(uint32_t id)
+{
+  switch (id) {
+    case 0x47U: return ("Thread");
+    case 0x6FU: return ("Semaphore");
+    case 0x5EU: return ("EventFlags");
+    case 0x26U: return ("MemoryPool");
+    case 0x17U: return ("Mutex");
+    case 0x7AU: return ("Timer");
+    case 0x1CU: return ("MessageQueue");
+    case 0x1EU: return ("DataQueue");
+    default:    return ("Object");
+  }
+}
+
+static const char *WaitName(uint32_t state)
+{
+  switch (state >> 4) {
+    case 0x1U: return ("ThreadFlags");
+    case 0x2U: return ("EventFlags");
+    case 0x3U: return ("Mutex");
+    case 0x4U: return ("Semaphore");
+    case 0x5U: return ("MemoryPool");
+    case 0x6U: return ("QueueGet");
+    case 0x7U: return ("QueuePut");
+    case 0x8U: return ("Delay");
+    default:   return ("Object");
+  }
+}
+
+static void PrintMetadata(void)
+{
+  printf(",\n  {\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Kernel\"}}", TID_KERNEL);
+  printf(",\n  {\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"(unknown)\"}}", TID_UNKNOWN);
+
+  for (uint32_t i = 0U; i < thread_count; i++) {
+    if (threads[i].addr == 0U) {
+      continue;
+    }
+    printf(",\n  {\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"name\":\"", threads[i].addr);
+    PrintName(threads[i].addr);
+    printf("\"}}");
+  }
+}
+
+/**
+ * @brief       Convert the records to trace events.
+ * @param[in]   buf   trace buffer image.
+ * @param[in]   size  size of the image in bytes.
+ * @param[in]   freq  system timer frequency, 0 - from the buffer header.
+ * @return      0 on success, -1 on error.
+ */
+static int Decode(const uint8_t *buf, size_t size, uint32_t freq)
+{
+  const uint8_t *rec;
+  Thread_t      *thread;
+  uint32_t       rec_size;
+  uint32_t       count;
+  uint32_t       first;
+  uint32_t       num;
+  uint32_t       time;
+  uint32_t       time_prev = 0U;
+  int64_t        time_acc  = 0;
+  uint32_t       event;
+  uint32_t       object;
+  uint32_t       arg;
+  uint32_t       curr = 0U;
+  double         ts;
+  double         ts_run = 0.0;
+
+  if ((size < sizeof(osTraceHeader_t)) || (GetWord(&buf[0]) != osTraceMagic)) {
+    fprintf(stderr, "trace2json: not a trace buffer\n");
+    return (-1);
+  }
+
+  rec_size = GetWord(&buf[4]);
+  count    = GetWord(&buf[8]);
+  if (freq == 0U) {
+    freq = GetWord(&buf[12]);
+  }
+  if ((rec_size == 0U) || (freq == 0U) ||
+      (size < sizeof(osTraceHeader_t) + (size_t)rec_size * sizeof(osTraceRecord_t))) {
+    fprintf(stderr, "trace2json: invalid trace header\n");
+    return (-1);
+  }
+
+  /* Oldest record */
+  if (count > rec_size) {
+    first = count % rec_size;
+    num   = rec_size;
+  }
+  else {
+    first = 0U;
+    num   = count;
+  }
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+  for (uint32_t i = 0U; i < num; i++) {
+    rec    = &buf[sizeof(osTraceHeader_t) + ((first + i) % rec_size) * sizeof(osTraceRecord_t)];
+    time   = GetWord(&rec[0]);
+    event  = GetWord(&rec[4]);
+    object = GetWord(&rec[8]);
+    arg    = GetWord(&rec[12]);
+
+    /* Extend the 32-bit system timer count. The count may step back while
+       the kernel is suspended in tickless idle, until the ticks are resumed */
+    if (i != 0U) {
+      time_acc += (int32_t)(time - time_prev);
+    }
+    time_prev = time;
+    ts = ((double)time_acc * 1000000.0) / (double)freq;
+
+    switch (osTraceCode(event)) {
+      case osTraceThreadSwitch:
+        if (curr != 0U) {
+          PrintEventBegin("X", "thread", ThreadTid(curr), ts_run);
+          printf(",\"dur\":%.3f,\"name\":\"Running\"}", ts - ts_run);
+        }
+        curr   = object;
+        ts_run = ts;
+        (void)ThreadGet(object);
+        break;
+
+      case osTraceServiceEnter:
+        thread = ThreadGet(curr);
+        if (thread != NULL) {
+          thread->depth++;
+        }
+        PrintEventBegin("B", "service", ThreadTid(curr), ts);
+        printf(",\"name\":\"");
+        PrintName(object);
+        printf("\",\"args\":{\"param\":\"0x%08" PRIX32 "\"}}", arg);
+        break;
+
+      case osTraceServiceExit:
+        /* The matching entry may have been overwritten */
+        thread = ThreadGet(curr);
+        if ((thread == NULL) || (thread->depth == 0U)) {
+          break;
+        }
+        thread->depth--;
+        PrintEventBegin("E", "service", ThreadTid(curr), ts);
+        printf(",\"args\":{\"return\":\"0x%08" PRIX32 "\"}}", arg);
+        break;
+
+      case osTracePostProcess:
+        PrintEventBegin("i", "isr", TID_KERNEL, ts);
+        printf(",\"s\":\"t\",\"name\":\"PostProcess %s\",\"args\":{\"object\":\"", ObjectName(osTraceDetail(event)));
+        PrintName(object);
+        printf("\"}}");
+        break;
+
+      case osTraceTick:
+        PrintEventBegin("i", "tick", TID_KERNEL, ts);
+        printf(",\"s\":\"t\",\"name\":\"Tick\",\"args\":{\"tick\":%" PRIu32 "}}", arg);
+        break;
+
+      case osTraceWaitEnter:
+        (void)ThreadGet(object);
+        PrintEventBegin("i", "wait", ThreadTid(object), ts);
+        printf(",\"s\":\"t\",\"name\":\"Wait %s\",\"args\":{\"timeout\":%" PRIu32 "}}",
+               WaitName(osTraceDetail(event)), arg);
+        break;
+
+      case osTraceWaitExit:
+        (void)ThreadGet(object);
+        PrintEventBegin("i", "wait", ThreadTid(object), ts);
+        printf(",\"s\":\"t\",\"name\":\"Wakeup\",\"args\":{\"return\":%" PRId32 "}}", (int32_t)arg);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  PrintMetadata();
+  printf("\n]}\n");
+
+  fprintf(stderr, "trace2json: %" PRIu32 " events (%" PRIu32 " lost), %" PRIu32 " threads\n",
+          num, count - num, thread_count);
+
+  return (0);
+}
+
+static void Usage(void)
+{
+  fprintf(stderr, "usage: trace2json [-s symbols] [-f freq] trace.bin > trace.json\n"
+                  "  -s symbols  nm output of the application\n"
+                  "  -f freq     system timer frequency [Hz], overrides the buffer header\n");
+}
+
+/*******************************************************************************
+ *  function implementations (scope: module-exported)
+ ******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  FILE       *file;
+  uint8_t    *buf;
+  long        size;
+  uint32_t    freq = 0U;
+  const char *path = NULL;
+  int         ret;
+
+  for (int i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+      if (!SymbolLoad(argv[++i])) {
+        fprintf(stderr, "trace2json: cannot read %s\n", argv[i]);
+        return (EXIT_FAILURE);
+      }
+    }
+    else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc)) {
+      freq = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((argv[i][0] != '-') && (path == NULL)) {
+      path = argv[i];
+    }
+    else {
+      Usage();
+      return (EXIT_FAILURE);
+    }
+  }
+
+  if (path == NULL) {
+    Usage();
+    return (EXIT_FAILURE);
+  }
+
+  file = fopen(path, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "trace2json: cannot open %s\n", path);
+    return (EXIT_FAILURE);
+  }
+
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  buf = malloc((size > 0) ? (size_t)size : 1U);
+  if ((buf == NULL) || (size < 0) || (fread(buf, 1U, (size_t)size, file) != (size_t)size)) {
+    fprintf(stderr, "trace2json: cannot read %s\n", path);
+    fclose(file);
+    return (EXIT_FAILURE);
+  }
+  fclose(file);
+
+  ret = Decode(buf, (size_t)size, freq);
+
+  free(buf);
+  free(symbols);
+
+  return ((ret == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/*------------------------------ End of file ---------------------------------*/